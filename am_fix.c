@@ -27,6 +27,8 @@
 #include "frequencies.h"
 #include "functions.h"
 #include "misc.h"
+#include "radio.h"
+#include "settings.h"
 
 #define SET_RSSI_COMP
 
@@ -228,9 +230,6 @@ static const unsigned int original_index = 90;
 // used simply to detect a changed gain setting
 unsigned int gain_table_index_prev[2] = {0, 0};
 
-// to help reduce gain hunting, peak hold count down tick
-unsigned int hold_counter[2] = {0, 0};
-
 // holds the previous RSSI level .. we do an average of old + new RSSI reading
 int16_t prev_rssi[2] = {0, 0};
 
@@ -240,6 +239,9 @@ int16_t rssi_gain_diff[2] = {0, 0};
 #ifndef ENABLE_AM_FIX_TEST1
 	// -89 dBm, any higher and the AM demodulator starts to saturate/clip/distort
 	const int16_t desired_rssi = (-89 + 160) * 2;
+
+	// the gain we're heading for, 1/16th dB units .. the table entry used is the one at or just under it
+	int16_t gain_dB_x16[2];
 #endif
 
 void AM_fix_init(void)
@@ -251,6 +253,7 @@ void AM_fix_init(void)
 			gain_table_index[vfo] = 1 + g_eeprom.config.setting.am_fix_test1;
 		#else
 			gain_table_index[vfo] = original_index;  // re-start with original QS setting
+			gain_dB_x16[vfo]      = gain_table[original_index].gain_dB * 16;
 		#endif
 		//AM_fix_reset(vfo);
 	}
@@ -267,7 +270,6 @@ void AM_fix_reset(const int vfo)
 	#endif
 
 	prev_rssi[vfo]             = 0;
-	hold_counter[vfo]          = 0;
 	rssi_gain_diff[vfo]        = 0;
 	gain_table_index_prev[vfo] = 0;
 	#ifdef ENABLE_AM_FIX_TEST1
@@ -277,6 +279,31 @@ void AM_fix_reset(const int vfo)
 	#endif
 }
 
+int AM_fix_rssi_cal(const unsigned int band)
+{	// the bands RSSI correction, 0.5dB units
+	const unsigned int cal = (band < ARRAY_SIZE(g_eeprom.calib.am_fix_rssi_cal)) ? g_eeprom.calib.am_fix_rssi_cal[band] : AM_FIX_RSSI_CAL_NONE;
+	return (cal >= (AM_FIX_RSSI_CAL_NONE - AM_FIX_RSSI_CAL_MAX) && cal <= (AM_FIX_RSSI_CAL_NONE + AM_FIX_RSSI_CAL_MAX)) ? (int)cal - AM_FIX_RSSI_CAL_NONE : 0;
+}
+
+#ifndef ENABLE_AM_FIX_TEST1
+	static unsigned int AM_fix_gain_index(const int gain_dB)
+	{	// highest gain table entry that isn't above the wanted gain .. the table is in ascending dB order
+		unsigned int lo = 1;
+		unsigned int hi = ARRAY_SIZE(gain_table) - 1;
+
+		while (lo < hi)
+		{
+			const unsigned int mid = (lo + hi + 1) / 2;
+			if (gain_table[mid].gain_dB <= gain_dB)
+				lo = mid;
+			else
+				hi = mid - 1;
+		}
+
+		return lo;
+	}
+#endif
+
 // adjust the RX gain to try and prevent the AM demodulator from
 // saturating (distorted AM audio)
 //
@@ -286,7 +313,6 @@ void AM_fix_reset(const int vfo)
 //
 void AM_fix_10ms(const int vfo)
 {
-	int16_t diff_dB;
 	int16_t rssi;
 
 	switch (g_current_function)
@@ -363,60 +389,44 @@ void AM_fix_10ms(const int vfo)
 
 #else
 	// automatically adjust the RF RX gain
+	//
+	// the signal level tells us straight away what gain would put it where we want it, so we head
+	// for that .. quickly when the gain has to come down (attack), slowly when it can go back up
+	// (decay), and not at all while the signal sits inside the hysteresis window under the target
 
-	// update the gain hold counter
-	if (hold_counter[vfo] > 0)
-		hold_counter[vfo]--;
-
-	// dB difference between actual and desired RSSI level
-	diff_dB = (rssi - desired_rssi) / 2;
-
-	if (diff_dB > 0)
-	{	// decrease gain
-
-		unsigned int index = gain_table_index[vfo];   // current position we're at
-
-		if (diff_dB >= 10)
-		{	// jump immediately to a new gain setting
-			// this greatly speeds up initial gain reduction (but reduces noise/spike immunity)
-
-			const int16_t desired_gain_dB = (int16_t)gain_table[index].gain_dB - diff_dB + 8; // get no closer than 8dB (bit of noise/spike immunity)
-
-			// scan the table to see what index to jump straight too
-			while (index > 1)
-				if (gain_table[--index].gain_dB <= desired_gain_dB)
-					break;
-
-			//index = (gain_table_index[vfo] + index) / 2;  // easy does it
+	{
+		const int     max_dB_x16 = gain_table[ARRAY_SIZE(gain_table) - 1].gain_dB * 16;
+		const int     min_dB_x16 = gain_table[1].gain_dB * 16;
+		const int     diff_dB    = (rssi - desired_rssi) / 2;    // dB difference between actual and desired RSSI level
+		int           target_x16 = ((int)gain_table[gain_table_index[vfo]].gain_dB - diff_dB - AM_FIX_HEADROOM_dB) * 16;
+		int           gain_x16   = gain_dB_x16[vfo];
+
+		target_x16 = (target_x16 < min_dB_x16) ? min_dB_x16 : (target_x16 > max_dB_x16) ? max_dB_x16 : target_x16;
+
+		if (diff_dB > 0)
+		{	// too strong, attack
+			if (target_x16 < gain_x16)
+				gain_x16 += (target_x16 - gain_x16 - (AM_FIX_ATTACK_TICKS - 1)) / AM_FIX_ATTACK_TICKS;
 		}
 		else
-		{	// incrementally reduce the gain .. taking it slow improves noise/spike immunity
-
-			//if (index >= (1 + 3) && diff_dB >= 3)
-			//	index -= 3;  // faster gain reduction
-			//else
-			if (index > 1)
-				index--;     // slow step-by-step gain reduction
+		if (diff_dB < -AM_FIX_HYSTERESIS_dB)
+		{	// room to spare, decay
+			if (target_x16 > gain_x16)
+				gain_x16 += (target_x16 - gain_x16 + (AM_FIX_DECAY_TICKS - 1)) / AM_FIX_DECAY_TICKS;
 		}
 
-		index = (index < 1) ? 1 : (index > (ARRAY_SIZE(gain_table) - 1)) ? ARRAY_SIZE(gain_table) - 1 : index;
+		gain_dB_x16[vfo] = gain_x16;
 
-		if (gain_table_index[vfo] != index)
 		{
-			gain_table_index[vfo] = index;  // save new gain setting to use
-			hold_counter[vfo] = 30;         // 300ms hold
+			const unsigned int index = AM_fix_gain_index(gain_x16 >> 4);
+			if (gain_table_index[vfo] != index)
+			{
+				gain_table_index[vfo] = index;
+				prev_rssi[vfo]        = 0;    // the last reading was at the old gain, don't average with it
+			}
 		}
 	}
 
-	if (diff_dB >= -6)                      // 6dB hysterisis (help reduce gain hunting)
-		hold_counter[vfo] = 30;             // 300ms hold
-
-	if (hold_counter[vfo] == 0)
-	{	// hold has been released, we're free to increase gain
-		const unsigned int index = gain_table_index[vfo] + 1;                 // move up to next gain index
-		gain_table_index[vfo] = (index < ARRAY_SIZE(gain_table)) ? index : ARRAY_SIZE(gain_table) - 1;  // limit the gain level we use
-	}
-
 #endif
 
 	{	// apply the new settings to the front end registers
@@ -432,8 +442,9 @@ void AM_fix_10ms(const int vfo)
 		// offset the RSSI reading to the rest of the firmware to cancel out the gain adjustments we make
 
 		#ifdef SET_RSSI_COMP
-			// RF gain difference from original QS setting
-			rssi_gain_diff[vfo] = ((int16_t)gain_table[index].gain_dB - gain_table[original_index].gain_dB) * 2;
+			// RF gain difference from original QS setting, less the bands calibrated correction
+			rssi_gain_diff[vfo] = (((int16_t)gain_table[index].gain_dB - gain_table[original_index].gain_dB) * 2) -
+			                      AM_fix_rssi_cal(g_vfo_info[vfo].channel_attributes.band);
 		#endif
 	}
 
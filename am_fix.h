@@ -21,12 +21,23 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+// the AM fix gain controller, 10ms ticks
+#define AM_FIX_ATTACK_TICKS    1     // gain comes down in one go when the signal gets too strong
+#define AM_FIX_DECAY_TICKS     50    // and creeps back up with a 500ms time constant
+#define AM_FIX_HEADROOM_dB     3     // aim this far under the demodulator's limit
+#define AM_FIX_HYSTERESIS_dB   6     // no gain increase unless the signal's this far under the limit
+
+// per band RSSI correction in the calibration area, 0.5dB units offset by AM_FIX_RSSI_CAL_NONE
+#define AM_FIX_RSSI_CAL_NONE   128
+#define AM_FIX_RSSI_CAL_MAX    40    // +/- 20dB
+
 extern int16_t rssi_gain_diff[2];
 
 void AM_fix_init(void);
 void AM_fix_reset(const int vfo);
 void AM_fix_10ms(const int vfo);
 void AM_fix_set_front_end_gains(const int vfo);
+int  AM_fix_rssi_cal(const unsigned int band);
 #ifdef ENABLE_AM_FIX_SHOW_DATA
 	void AM_fix_print_data(const int vfo, char *s);
 #endif
@@ -263,10 +263,24 @@ void ACTION_Scan(bool bRestart)
 		}
 		
 		#ifdef ENABLE_SCAN_RANGES
+			g_scan_range_index = -1;
+
 			if (IS_FREQ_CHANNEL(g_tx_vfo->channel_save) && g_eeprom.config.setting.scan_ranges_enable)
 			{
-				uint32_t freq = g_tx_vfo->freq_config_rx.frequency;
-				FREQUENCY_scan_range(freq, &g_scan_initial_lower, &g_scan_initial_upper, &g_scan_initial_step_size);
+				uint32_t  freq  = g_tx_vfo->freq_config_rx.frequency;
+				const int range = FREQUENCY_scan_range_find(freq);
+
+				if (range >= 0)
+				{	// scan the stored ranges, the VFO's mode/step/bandwidth is put back when the scan stops
+					g_scan_restore_mod_mode     = g_tx_vfo->channel.mod_mode;
+					g_scan_restore_bandwidth    = g_tx_vfo->channel.channel_bandwidth;
+					g_scan_restore_step_setting = g_tx_vfo->channel.step_setting;
+					RADIO_select_scan_range(range);
+				}
+				else
+				{
+					FREQUENCY_scan_range(freq, &g_scan_initial_lower, &g_scan_initial_upper, &g_scan_initial_step_size);
+				}
 //				freq = FREQUENCY_floor_to_step(freq, g_scan_initial_step_size, g_scan_initial_lower, g_scan_initial_upper);			}
 			}
 		#endif
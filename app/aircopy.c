@@ -337,6 +337,8 @@ void AIRCOPY_process_fsk_rx_10ms(void)
 	uint16_t           crc2;
 	uint16_t           eeprom_addr;
 	uint8_t           *data;
+	uint16_t           block_addr;
+	uint8_t           *block_data;
 	unsigned int       block_num;
 	bool               req_ack_packet = false;
 	unsigned int       i;
@@ -568,7 +570,10 @@ void AIRCOPY_process_fsk_rx_10ms(void)
 	g_aircopy_rx_errors_magic   = 0;
 	g_aircopy_rx_errors_crc     = 0;
 
-	// eeprom block appears valid .. write it directly to eeprom
+	// eeprom block appears valid .. wipe what we don't want then write it to eeprom in one go
+
+	block_addr = eeprom_addr;
+	block_data = data;
 
 	for (i = 0; i < (block_size / write_size); i++)
 	{
@@ -591,16 +596,13 @@ void AIRCOPY_process_fsk_rx_10ms(void)
 			data[2] = 0;
 		}
 
-		if (eeprom_addr < sizeof(t_config))		// don't allow writing to the calibration data area
-		{
-			EEPROM_WriteBuffer8(eeprom_addr, data);   // 8 bytes at a time
-//			memcpy(((uint8_t *)&g_eeprom) + eeprom_addr, data, 8);
-		}
-
 		data        += write_size / sizeof(data[0]);
 		eeprom_addr += write_size;
 	}
 
+	if (block_addr < sizeof(t_config))		// don't allow writing to the calibration data area
+		EEPROM_WriteBuffer(block_addr, block_data, (block_size <= (sizeof(t_config) - block_addr)) ? block_size : sizeof(t_config) - block_addr);
+
 	g_aircopy_block_number = block_num + 1;
 	g_fsk_write_index      = 0;
 
@@ -611,6 +613,7 @@ void AIRCOPY_process_fsk_rx_10ms(void)
 
 		// save the received data to the EEPROM chip
 //		SETTINGS_write_eeprom_config();
+		EEPROM_flush();
 
 		#ifdef ENABLE_AIRCOPY_RX_REBOOT
 			#if defined(ENABLE_OVERLAY)
@@ -14,6 +14,8 @@
  *     limitations under the License.
  */
 
+#include <string.h>
+
 #ifdef ENABLE_AM_FIX
 	#include "am_fix.h"
 #endif
@@ -40,10 +42,12 @@
 	#include "driver/bk1080.h"
 #endif
 #include "driver/bk4819.h"
+#include "driver/eeprom.h"
 #include "driver/gpio.h"
 #include "driver/keyboard.h"
 #include "driver/st7565.h"
 #include "driver/system.h"
+#include "driver/systick.h"
 #if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
 	#include "driver/uart.h"
 #endif
@@ -62,7 +66,11 @@
 #ifdef ENABLE_PANADAPTER
 	#include "panadapter.h"
 #endif
+#include "profile.h"
 #include "radio.h"
+#ifdef ENABLE_SCAN_LOG
+	#include "scan_log.h"
+#endif
 #include "settings.h"
 #if defined(ENABLE_OVERLAY)
 	#include "sram-overlay.h"
@@ -76,6 +84,40 @@
 
 static void APP_process_key(const key_code_t Key, const bool key_pressed, const bool key_held);
 
+#ifdef ENABLE_FASTER_CHANNEL_SCAN
+	// the frequency scan dwell is in stages .. a quick look at the RSSI as soon as the PLL
+	// has settled, an early look at the RSSI/noise/glitch 20ms in, then the rest of the dwell
+	// (for the squelch to make it's mind up) only if the frequency looks like it might have
+	// something on it
+	#define SCAN_DWELL_10MS        6    // 60ms, the full dwell
+	#define SCAN_EARLY_LOOK_10MS   2    // 20ms into the dwell
+	#define SCAN_FLOOR_MARGIN      12   // 6dB above the noise floor, RSSI is in 0.5dB steps
+	#define SCAN_SETTLE_TIMEOUT_US 2000 // longest we wait for the synthesizer after a hop
+	#define SCAN_HOP_BUDGET_US     4000 // longest we keep hopping within the one 10ms time slice
+	#define SCAN_CONFIRM_US        250  // gap between the two RSSI reads of the quick look
+	#define SCAN_RISE_MARGIN       4    // 2dB, RSSI still climbing by more than this is a signal coming through
+
+	#define CYCLES_PER_US          (CPU_CLOCK_HZ / 1000000u)
+
+	static uint16_t scan_noise_floor_x8;   // running average RSSI of the empty frequencies x 8, 0 = none yet
+	static bool     scan_early_look;       // the current frequency hasn't had it's early look yet
+	static uint16_t scan_hop_count;        // hops since g_scan_hops_per_sec was last updated
+#endif
+
+#ifdef ENABLE_PRIORITY_LOOK_BACK
+	// every so often (menu "PRI LK") we leave the channel we're scanning/receiving on for
+	// just long enough to sample the RSSI/noise on the priority channel(s), only moving
+	// over to one if it's active .. and back again once it's gone quiet if we weren't scanning
+	#define PRIORITY_SETTLE_TIMEOUT_US   2000   // longest we wait for the synthesizer on each retune
+	#define PRIORITY_NOISE_DELAY_US      2000   // for the noise indicator to catch up with the RSSI
+
+	static uint16_t     priority_look_tick_10ms;
+	static int          priority_home = -1;     // channel we were moved off, -1 = none
+	static unsigned int priority_home_vfo;      // on this VFO
+	static uint8_t      priority_active;        // the priority channel we were moved to
+	static uint16_t     priority_hold_10ms;     // quiet time left before going back
+#endif
+
 static void APP_update_rssi(const int vfo, const bool force)
 {
 	int16_t rssi   = BK4819_GetRSSI();
@@ -157,6 +199,10 @@ static void APP_check_for_new_receive(void)
 
 		g_scan_tick_10ms       = scan_pause_chan_10ms;
 		g_scan_pause_time_mode = false;
+
+		#ifdef ENABLE_SCAN_LOG
+			SCAN_LOG_hit();
+		#endif
 	}
 
 	g_rx_reception_mode = RX_MODE_DETECTED;
@@ -629,6 +675,10 @@ bool APP_start_listening(void)
 
 void APP_stop_scan(void)
 {
+	#ifdef ENABLE_SCAN_RANGES
+		const bool scan_ranges = (g_scan_range_index >= 0);
+	#endif
+
 	if (g_scan_state_dir == SCAN_STATE_DIR_OFF)
 		return;   // but, but, we weren't doing anything !
 
@@ -636,6 +686,10 @@ void APP_stop_scan(void)
 
 	g_scan_state_dir = SCAN_STATE_DIR_OFF;
 
+	#ifdef ENABLE_SCAN_RANGES
+		g_scan_range_index = -1;
+	#endif
+
 	if (g_scan_pause_time_mode ||
 		g_scan_tick_10ms > (200 / 10) ||
 		g_monitor_enabled ||
@@ -669,6 +723,16 @@ void APP_stop_scan(void)
 
 			g_rx_vfo->freq_config_rx.frequency = g_scan_restore_frequency;
 
+			#ifdef ENABLE_SCAN_RANGES
+				if (scan_ranges)
+				{	// and whatever the scan ranges changed, they were saved from and changed on the TX VFO
+					g_tx_vfo->channel.mod_mode          = g_scan_restore_mod_mode;
+					g_tx_vfo->channel.channel_bandwidth = g_scan_restore_bandwidth;
+					g_tx_vfo->channel.step_setting      = g_scan_restore_step_setting;
+					g_tx_vfo->step_freq                 = STEP_FREQ_TABLE[g_scan_restore_step_setting];
+				}
+			#endif
+
 			// find the first channel that contains this frequency
 			g_rx_vfo->freq_in_channel = SETTINGS_find_channel(g_rx_vfo->freq_config_rx.frequency);
 
@@ -703,6 +767,33 @@ void APP_stop_scan(void)
 	g_update_status = true;
 }
 
+#ifdef ENABLE_SCAN_RANGES
+	static bool scan_range_changed;
+
+	static uint32_t APP_next_range_freq(uint32_t freq)
+	{	// step through the stored scan ranges, moving on to the next one off either end of this one
+		if (freq >= g_scan_initial_lower && freq < g_scan_initial_upper)
+		{
+			freq  = FREQUENCY_floor_to_step(freq, g_scan_initial_step_size, g_scan_initial_lower, g_scan_initial_upper);
+			freq += g_scan_initial_step_size * g_scan_state_dir;
+			if (freq >= g_scan_initial_lower && freq < g_scan_initial_upper)
+				return freq;
+
+			{
+				const int index = FREQUENCY_scan_range_next(g_scan_range_index, g_scan_state_dir);
+				if (index != g_scan_range_index)
+				{
+					RADIO_select_scan_range(index);
+					scan_range_changed = true;
+				}
+			}
+		}
+
+		// onto the near edge of the range
+		return (g_scan_state_dir > 0) ? g_scan_initial_lower : g_scan_initial_upper - g_scan_initial_step_size;
+	}
+#endif
+
 static void APP_next_freq(void)
 {
 	uint32_t freq = g_tx_vfo->freq_config_rx.frequency;
@@ -710,6 +801,13 @@ static void APP_next_freq(void)
 	#ifdef ENABLE_SCAN_IGNORE_LIST
 		do {
 	#endif
+
+		#ifdef ENABLE_SCAN_RANGES
+			if (g_scan_range_index >= 0)
+				freq = APP_next_range_freq(freq);
+			else
+		#endif
+		{
 			freq += g_scan_initial_step_size * g_scan_state_dir;
 
 			// wrap-a-round
@@ -726,6 +824,7 @@ static void APP_next_freq(void)
 			#else
 				//freq = FREQUENCY_floor_to_step(freq, g_scan_initial_step_size, g_scan_initial_lower, g_scan_initial_upper);
 			#endif
+		}
 
 	#ifdef ENABLE_SCAN_IGNORE_LIST
 		} while (FI_freq_ignored(freq) >= 0);
@@ -759,9 +858,23 @@ static void APP_next_freq(void)
 
 		RADIO_apply_offset(g_tx_vfo, false);
 
+		#ifdef ENABLE_SCAN_RANGES
+			if (scan_range_changed)
+			{	// the squelch thresholds are per band, the rest of the radio set up stays as it is
+				scan_range_changed = false;
+				RADIO_ConfigureSquelch(g_tx_vfo);
+				BK4819_SetupSquelch(
+					g_tx_vfo->squelch_open_rssi_thresh,    g_tx_vfo->squelch_close_rssi_thresh,
+					g_tx_vfo->squelch_open_noise_thresh,   g_tx_vfo->squelch_close_noise_thresh,
+					g_tx_vfo->squelch_close_glitch_thresh, g_tx_vfo->squelch_open_glitch_thresh);
+			}
+		#endif
+
 		#ifdef ENABLE_FASTER_CHANNEL_SCAN
 			//g_scan_tick_10ms = 10;   // 100ms
-			g_scan_tick_10ms = 6;      // 60ms
+			g_scan_tick_10ms = SCAN_DWELL_10MS;
+			scan_early_look  = true;
+			scan_hop_count++;
 		#else
 			g_scan_tick_10ms = scan_pause_freq_10ms;
 		#endif
@@ -772,6 +885,71 @@ static void APP_next_freq(void)
 	g_update_display       = true;
 }
 
+#ifdef ENABLE_FASTER_CHANNEL_SCAN
+	static bool APP_scan_freq_empty(const bool full_look)
+	{	// true if the squelch would stay closed here, or the RSSI is down in the noise floor
+		//
+		// the quick look straight after the retune only has the RSSI to go on, the noise
+		// and glitch indicators take longer to catch up with the new frequency
+		uint16_t rssi = BK4819_GetRSSI();
+		bool     empty;
+
+		if (g_rx_vfo->squelch_open_rssi_thresh == 0)
+			return false;   // squelch is off, stop on everything as before
+
+		if (!full_look)
+		{	// the RSSI is filtered, so straight after the retune it can still be showing the last
+			// frequency .. only the second of two reads counts, and a signal coming through shows
+			// as the RSSI still climbing between them
+			const uint16_t first = rssi;
+
+			SYSTICK_Delay250ns(SCAN_CONFIRM_US * 4);
+
+			rssi = BK4819_GetRSSI();
+			if (rssi > (first + SCAN_RISE_MARGIN))
+				return false;
+		}
+
+		empty = rssi < g_rx_vfo->squelch_close_rssi_thresh;
+
+		if (full_look)
+			empty = empty ||
+			        BK4819_GetExNoiceIndicator() > g_rx_vfo->squelch_close_noise_thresh ||
+			        BK4819_GetGlitchIndicator()  > g_rx_vfo->squelch_close_glitch_thresh;
+
+		if (scan_noise_floor_x8 > 0 && rssi < ((scan_noise_floor_x8 / 8) + SCAN_FLOOR_MARGIN))
+			empty = true;
+
+		if (!empty)
+			return false;   // a candidate, give the squelch the full dwell
+
+		// track the noise floor only with readings the squelch would reject on the RSSI alone,
+		// weak signals above that would otherwise drag the floor up under stronger ones
+		if (rssi < g_rx_vfo->squelch_close_rssi_thresh)
+			scan_noise_floor_x8 = (scan_noise_floor_x8 == 0) ? rssi * 8 : scan_noise_floor_x8 + rssi - (scan_noise_floor_x8 / 8);
+
+		return empty;
+	}
+
+	static void APP_scan_next_freqs(void)
+	{	// hop on past the empty frequencies for as long as this time slice allows, each
+		// getting a quick look as soon as the synthesizer has settled on it
+		const uint32_t start = SYSTICK_get_cycles();
+
+		while (1)
+		{
+			APP_next_freq();
+
+			if ((SYSTICK_get_cycles() - start) >= (SCAN_HOP_BUDGET_US * CYCLES_PER_US) ||
+			    !BK4819_wait_rf_settled(SCAN_SETTLE_TIMEOUT_US) ||
+			    !APP_scan_freq_empty(false))
+			{
+				break;   // leave this one to the early look and the dwell
+			}
+		}
+	}
+#endif
+
 static void APP_next_channel(void)
 {
 	static unsigned int prevChannel = 0;
@@ -870,6 +1048,7 @@ static void APP_next_channel(void)
 
 	#ifdef ENABLE_FASTER_CHANNEL_SCAN
 		g_scan_tick_10ms = 9;  // 90ms .. <= ~60ms it misses signals (squelch response and/or PLL lock time) ?
+		scan_hop_count++;
 	#else
 		g_scan_tick_10ms = scan_pause_chan_10ms;
 	#endif
@@ -881,6 +1060,235 @@ static void APP_next_channel(void)
 			g_scan_current_scan_list = SCAN_NEXT_CHAN_SCANLIST1;  // back round we go
 }
 
+static void APP_squelch_closed(void)
+{
+	g_squelch_open = false;
+
+	BK4819_set_GPIO_pin(BK4819_GPIO6_PIN2_GREEN, false);  // LED off
+
+	if (!g_monitor_enabled)
+		GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_SPEAKER);
+
+	#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
+		UART_SendText("sq close\r\n");
+	#endif
+
+	//APP_update_rssi(g_rx_vfo_num, false);
+	g_update_rssi = true;
+
+	g_update_display = true;
+}
+
+static void APP_squelch_opened(void)
+{
+	BK4819_set_GPIO_pin(BK4819_GPIO6_PIN2_GREEN, true);   // LED on
+	g_squelch_open = true;
+
+	#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
+		UART_SendText("sq open\r\n");
+	#endif
+
+	//APP_update_rssi(g_rx_vfo_num, false);
+	g_update_rssi = true;
+
+	if (g_monitor_enabled)
+		BK4819_set_GPIO_pin(BK4819_GPIO6_PIN2_GREEN, true);  // LED on
+
+	g_update_display = true;
+}
+
+#ifdef ENABLE_PRIORITY_LOOK_BACK
+	static unsigned int APP_priority_channels(uint8_t *channels)
+	{	// the priority channels of the current scan list (both lists if scanning all of them)
+		const unsigned int index = g_eeprom.config.setting.scan_list_default;
+		unsigned int       count = 0;
+		unsigned int       i;
+
+		for (i = 0; i < ARRAY_SIZE(g_eeprom.config.setting.priority_scan_list); i++)
+		{
+			unsigned int k;
+
+			if ((index < 2 && i != index) || !g_eeprom.config.setting.priority_scan_list[i].enabled)
+				continue;
+
+			for (k = 0; k < ARRAY_SIZE(g_eeprom.config.setting.priority_scan_list[i].channel); k++)
+			{
+				const unsigned int chan = g_eeprom.config.setting.priority_scan_list[i].channel[k];
+				if (IS_USER_CHANNEL(chan) && RADIO_channel_valid(chan, false, 0) && memchr(channels, chan, count) == NULL)
+					channels[count++] = chan;
+			}
+		}
+
+		return count;
+	}
+
+	static bool APP_priority_channel_active(const unsigned int chan, const uint32_t freq)
+	{	// a look at the RSSI as soon as the synthesizer has settled, then the noise and glitch only
+		// if the RSSI says so .. against the same thresholds the chip would open it's squelch on
+		const t_channel        *p_chan   = &g_eeprom.config.channel[chan];
+		const unsigned int      level    = (p_chan->squelch_level > 0) ? p_chan->squelch_level : g_eeprom.config.setting.squelch_level;
+		const squelch_thresh_t *p_thresh = RADIO_squelch_thresh(freq, level);
+
+		if (p_thresh == NULL)
+			return false;   // squelch off, it would always look active
+
+		BK4819_set_rf_frequency(freq, true);
+		BK4819_set_rf_filter_path(freq);
+
+		if (!BK4819_wait_rf_settled(PRIORITY_SETTLE_TIMEOUT_US))
+			return false;
+
+		if (BK4819_GetRSSI() < p_thresh->open_rssi)
+			return false;
+
+		SYSTICK_Delay250ns(PRIORITY_NOISE_DELAY_US * 4);
+
+		return BK4819_GetExNoiceIndicator() <= p_thresh->open_noise && BK4819_GetGlitchIndicator() <= p_thresh->open_glitch;
+	}
+
+	static void APP_priority_look_back(void)
+	{	// sample the priority channels without touching the rest of the register set up, the
+		// BK4819 interrupts and the audio are held off while we're away from our own channel
+		uint8_t            channels[4];
+		const unsigned int count    = APP_priority_channels(channels);
+		const unsigned int current  = g_rx_vfo->channel_save;
+		const uint32_t     freq     = g_rx_vfo->p_rx->frequency;
+		uint16_t           int_mask;
+		uint16_t           af;
+		unsigned int       i;
+		int                active   = -1;
+
+		if (count == 0 || memchr(channels, current, count) != NULL)
+			return;   // nothing to look at, or we're already on a priority channel
+
+		int_mask = BK4819_read_reg(0x3F);
+		af       = BK4819_read_reg(0x47);
+		BK4819_write_reg(0x3F, 0);
+		BK4819_SetAF(BK4819_AF_MUTE);
+
+		for (i = 0; i < count && active < 0; i++)
+		{
+			const uint32_t pri_freq = SETTINGS_fetch_channel_frequency(channels[i]);
+			if (pri_freq != 0 && APP_priority_channel_active(channels[i], pri_freq))
+				active = channels[i];
+		}
+
+		// back to our own channel
+		BK4819_set_rf_frequency(freq, true);
+		BK4819_set_rf_filter_path(freq);
+		BK4819_wait_rf_settled(PRIORITY_SETTLE_TIMEOUT_US);
+
+		BK4819_write_reg(0x02, 0);   // throw away anything the trip caused
+		BK4819_write_reg(0x47, af);
+		BK4819_write_reg(0x3F, int_mask);
+
+		// the squelch interrupts were off while we were away, so catch up with
+		// whatever the squelch did in that time .. a change from here on interrupts as usual
+		if (BK4819_is_squelch_open() != g_squelch_open)
+		{
+			if (g_squelch_open)
+				APP_squelch_closed();
+			else
+				APP_squelch_opened();
+		}
+
+		if (active < 0)
+			return;
+
+		// the priority channel has something on it, over we go
+		g_eeprom.config.setting.indices.vfo[g_rx_vfo_num].user   = active;
+		g_eeprom.config.setting.indices.vfo[g_rx_vfo_num].screen = active;
+
+		if (g_scan_state_dir != SCAN_STATE_DIR_OFF)
+		{	// let the scan have it's usual look at it
+			g_scan_next_channel    = active;
+			g_scan_tick_10ms       = scan_pause_chan_10ms;
+			g_scan_pause_time_mode = false;
+		}
+		else
+		{	// only for as long as it's active, the VFO isn't saved
+			if (priority_home < 0)
+			{
+				priority_home     = current;
+				priority_home_vfo = g_rx_vfo_num;
+			}
+			priority_active    = active;
+			priority_hold_10ms = g_eeprom.config.setting.scan_hold_time * 50;
+		}
+
+		RADIO_configure_channel(g_rx_vfo_num, VFO_CONFIGURE_RELOAD);
+		RADIO_setup_registers(true);
+
+		g_update_display = true;
+	}
+
+	static void APP_priority_return(void)
+	{	// back to the channel the look back moved us off, once the priority channel's squelch
+		// has been closed for the scan hold time
+		const unsigned int vfo = priority_home_vfo;
+
+		if (g_scan_state_dir != SCAN_STATE_DIR_OFF || g_eeprom.config.setting.indices.vfo[vfo].screen != priority_active)
+		{	// the user has moved on from it, stay where they are
+			priority_home = -1;
+			return;
+		}
+
+		if (g_current_function == FUNCTION_TRANSMIT || (g_rx_vfo_num == vfo && g_current_function == FUNCTION_RECEIVE))
+		{	// still in use
+			priority_hold_10ms = g_eeprom.config.setting.scan_hold_time * 50;
+			return;
+		}
+
+		if (priority_hold_10ms > 0 && --priority_hold_10ms > 0)
+			return;
+
+		g_eeprom.config.setting.indices.vfo[vfo].user   = priority_home;
+		g_eeprom.config.setting.indices.vfo[vfo].screen = priority_home;
+		priority_home = -1;
+
+		RADIO_configure_channel(vfo, VFO_CONFIGURE_RELOAD);
+		RADIO_setup_registers(true);
+
+		g_update_display = true;
+	}
+
+	static void APP_process_priority_look_back(void)
+	{
+		const bool channel_scan = g_scan_state_dir != SCAN_STATE_DIR_OFF && g_scan_next_channel <= USER_CHANNEL_LAST;
+
+		if (priority_home >= 0)
+			APP_priority_return();
+
+		if (g_eeprom.config.setting.priority_look_back == 0 ||
+		    g_css_scan_mode != CSS_SCAN_MODE_OFF ||
+		    g_current_display_screen == DISPLAY_SEARCH ||
+		   !IS_USER_CHANNEL(g_rx_vfo->channel_save) ||
+		   (g_current_function != FUNCTION_RECEIVE && !(channel_scan && g_current_function == FUNCTION_FOREGROUND)))
+		{
+			priority_look_tick_10ms = 0;
+			return;
+		}
+
+		#ifdef ENABLE_PANADAPTER
+			if (PAN_scanning())
+				return;
+		#endif
+
+		if (priority_look_tick_10ms == 0)
+		{	// start the count down
+			priority_look_tick_10ms = g_eeprom.config.setting.priority_look_back * 10;
+			return;
+		}
+
+		if (--priority_look_tick_10ms > 0)
+			return;
+
+		SETTINGS_load_deferred_all();   // the priority channels may not be in yet
+
+		APP_priority_look_back();
+	}
+#endif
+
 #ifdef ENABLE_NOAA
 	static void APP_next_noaa(void)
 	{
@@ -953,6 +1361,8 @@ void APP_process_radio_interrupts(void)
 	if (g_current_display_screen == DISPLAY_SEARCH)
 		return;
 
+	PROFILE_start(PROFILE_RADIO_IRQ);
+
 	while (1)
 	{	// BK4819 chip interrupt request
 
@@ -1111,46 +1521,17 @@ void APP_process_radio_interrupts(void)
 		#endif
 
 		if (int_bits & BK4819_REG_02_SQUELCH_CLOSED)
-		{
-			g_squelch_open = false;
-
-			BK4819_set_GPIO_pin(BK4819_GPIO6_PIN2_GREEN, false);  // LED off
-
-			if (!g_monitor_enabled)
-				GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_SPEAKER);
-
-			#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
-				UART_SendText("sq close\r\n");
-			#endif
-
-			//APP_update_rssi(g_rx_vfo_num, false);
-			g_update_rssi = true;
-
-			g_update_display = true;
-		}
+			APP_squelch_closed();
 
 		if (int_bits & BK4819_REG_02_SQUELCH_OPENED)
-		{
-			BK4819_set_GPIO_pin(BK4819_GPIO6_PIN2_GREEN, true);   // LED on
-			g_squelch_open = true;
-
-			#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
-				UART_SendText("sq open\r\n");
-			#endif
-
-			//APP_update_rssi(g_rx_vfo_num, false);
-			g_update_rssi = true;
-
-			if (g_monitor_enabled)
-				BK4819_set_GPIO_pin(BK4819_GPIO6_PIN2_GREEN, true);  // LED on
-
-			g_update_display = true;
-		}
+			APP_squelch_opened();
 
 		#ifdef ENABLE_MDC1200
 			MDC1200_process_rx(int_bits);
 		#endif
 	}
+
+	PROFILE_stop(PROFILE_RADIO_IRQ);
 }
 
 void APP_end_tx(void)
@@ -1554,6 +1935,12 @@ void APP_channel_next(const bool remember_current, const scan_state_dir_t scan_d
 	{
 		g_scan_restore_channel   = 0xff;
 		g_scan_restore_frequency = 0xffffffff;
+
+		#ifdef ENABLE_FASTER_CHANNEL_SCAN
+			scan_noise_floor_x8 = 0;   // new scan, new noise floor
+			scan_hop_count      = 0;
+			g_scan_hops_per_sec = 0;
+		#endif
 	}
 
 	#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
@@ -1662,8 +2049,30 @@ void APP_process_scan(void)
 				APP_next_channel();
 			else
 			if (IS_FREQ_CHANNEL(g_scan_next_channel))
-				APP_next_freq();
+			{
+				#ifdef ENABLE_FASTER_CHANNEL_SCAN
+					APP_scan_next_freqs();
+				#else
+					APP_next_freq();
+				#endif
+			}
 		}
+		#ifdef ENABLE_FASTER_CHANNEL_SCAN
+			else
+			if (scan_early_look && g_scan_tick_10ms <= (SCAN_DWELL_10MS - SCAN_EARLY_LOOK_10MS))
+			{	// early look at the frequency
+				scan_early_look = false;
+
+				if (g_current_function == FUNCTION_FOREGROUND &&
+				   !g_scan_pause_time_mode &&
+				    IS_FREQ_CHANNEL(g_scan_next_channel) &&
+				    APP_scan_freq_empty(true))
+				{	// nothing here, move on now
+					g_rx_reception_mode = RX_MODE_NONE;
+					APP_scan_next_freqs();
+				}
+			}
+		#endif
 /*
 		if (g_scan_next_channel <= USER_CHANNEL_LAST)
 		{	// channel mode
@@ -1978,7 +2387,32 @@ void APP_process_power_save(void)
 // this is called once every 500ms
 void APP_time_slice_500ms(void)
 {
-	bool exit_menu = false;
+	static uint8_t lcd_refresh_tick_500ms = 0;
+	bool           exit_menu              = false;
+
+	if (++lcd_refresh_tick_500ms >= lcd_refresh_500ms)
+	{	// the blits only send what's changed, so every now and then reset some of the
+		// displays settings and resend it all to overcome RF corrupting the display
+		lcd_refresh_tick_500ms = 0;
+		ST7565_refresh();
+	}
+
+	#ifdef ENABLE_FASTER_CHANNEL_SCAN
+	{	// measured scan rate, updated once a second
+		static uint8_t scan_rate_tick_500ms = 0;
+
+		if (++scan_rate_tick_500ms >= 2)
+		{
+			scan_rate_tick_500ms = 0;
+
+			if (g_scan_hops_per_sec != scan_hop_count && g_scan_state_dir != SCAN_STATE_DIR_OFF)
+				g_update_status = true;
+
+			g_scan_hops_per_sec = scan_hop_count;
+			scan_hop_count      = 0;
+		}
+	}
+	#endif
 
 	if (g_key_input_count_down > 0)
 	{
@@ -2093,6 +2527,8 @@ void APP_time_slice_500ms(void)
 
 		if (g_usb_current > 500 || g_eeprom.calib.battery[3] < g_usb_current_voltage)
 		{
+			EEPROM_flush();
+
 			#ifdef ENABLE_OVERLAY
 				overlay_FLASH_RebootToBootloader();
 			#else
@@ -2376,6 +2812,10 @@ void APP_time_slice_10ms(void)
 		g_flag_save_settings = false;
 	}
 
+	EEPROM_flush_10ms();
+
+	SETTINGS_load_deferred();
+
 	if (g_request_display_screen != DISPLAY_INVALID)
 	{
 		GUI_SelectNextDisplay(g_request_display_screen);
@@ -2495,6 +2935,10 @@ void APP_time_slice_10ms(void)
 
 	APP_process_functions();
 
+	#ifdef ENABLE_SCAN_LOG
+		SCAN_LOG_10ms();
+	#endif
+
 	APP_process_flash_light_10ms();
 
 	if (g_current_function == FUNCTION_TRANSMIT)
@@ -2558,6 +3002,10 @@ void APP_time_slice_10ms(void)
 
 	APP_process_power_save();
 
+	#ifdef ENABLE_PRIORITY_LOOK_BACK
+		APP_process_priority_look_back();
+	#endif
+
 	APP_process_scan();
 
 	APP_process_search();
@@ -2572,6 +3020,9 @@ static void APP_process_key(const key_code_t Key, const bool key_pressed, const
 	if (Key == KEY_INVALID && !key_pressed && !key_held)
 		return;
 
+	// anything from here on might want a channel, name or contact that's not been loaded yet
+	SETTINGS_load_deferred_all();
+
 	// reset the state so as to remove it from the screen
 	if (Key != KEY_INVALID && Key != KEY_PTT)
 		RADIO_set_vfo_state(VFO_STATE_NORMAL);
@@ -99,6 +99,7 @@ bool DTMF_GetContact(const int Index, char *pContact)
 	int i = -1;
 	if (Index >= 0 && Index < (int)ARRAY_SIZE(g_eeprom.config.dtmf_contact))
 	{
+		SETTINGS_load_deferred_all();
 		memcpy(pContact, &g_eeprom.config.dtmf_contact[Index], 16);
 //		EEPROM_ReadBuffer(0x1C00 + (Index * 16), pContact, 16);
 		i = (int)pContact[0] - ' ';
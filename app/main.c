@@ -22,7 +22,6 @@
 #include "app/generic.h"
 #include "app/main.h"
 #include "app/search.h"
-//#define ENABLE_SPECTRUM
 #ifdef ENABLE_SPECTRUM
 	#include "app/spectrum.h"
 #endif
@@ -393,11 +392,6 @@ void processFKeyFunction(const key_code_t Key)
 			#else
 				toggle_chan_scanlist();
 			#endif
-#ifdef	ENABLE_SPECTRUM
-					APP_RunSpectrum();
-					g_request_display_screen = DISPLAY_MAIN;
-
-#endif
 
 			break;
 
@@ -419,6 +413,10 @@ void processFKeyFunction(const key_code_t Key)
 				ACTION_Vox();
 			#elif defined(ENABLE_NOAA)
 				toggle_chan_scanlist();
+			#elif defined(ENABLE_SPECTRUM)
+				APP_stop_scan();
+				APP_RunSpectrum();
+				g_request_display_screen = DISPLAY_MAIN;
 			#endif
 
 			break;
@@ -882,14 +880,16 @@ void MAIN_Key_STAR(bool key_pressed, bool key_held)
 
 	if (!g_fkey_pressed)
 	{	// pressed without the F-key
-
 		if (g_scan_state_dir != SCAN_STATE_DIR_OFF)
 		{	// RF scanning
 
 			#ifdef ENABLE_SCAN_IGNORE_LIST
 				if (scanning_paused())
-				{
-					if (!FI_add_freq_ignored(g_rx_vfo->freq_config_rx.frequency))
+				{	// ignore the scan step's worth of spectrum around it, neighbouring steps merge into one range
+					const uint32_t freq = g_rx_vfo->freq_config_rx.frequency;
+					const uint32_t half = g_scan_initial_step_size / 2;
+
+					if (!FI_add_range_ignored(freq - half, freq + (g_scan_initial_step_size - half) - ((g_scan_initial_step_size > 0) ? 1 : 0), true))
 						g_beep_to_play = BEEP_500HZ_60MS_DOUBLE_BEEP_OPTIONAL;  // not added for some reason
 
 					// immediately continue the scan
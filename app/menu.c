@@ -17,6 +17,9 @@
 #if !defined(ENABLE_OVERLAY)
 	#include "ARMCM0.h"
 #endif
+#ifdef ENABLE_AM_FIX
+	#include "am_fix.h"
+#endif
 #include "app/dtmf.h"
 #include "app/generic.h"
 #include "app/menu.h"
@@ -47,6 +50,9 @@
 	#include "panadapter.h"
 #endif
 #include "radio.h"
+#ifdef ENABLE_SCAN_LOG
+	#include "scan_log.h"
+#endif
 #include "settings.h"
 #include "ui/ui.h"
 
@@ -139,6 +145,27 @@ int MENU_GetLimits(uint8_t Cursor, int32_t *pMin, int32_t *pMax)
 			*pMin = 2;    //  1 second
 			*pMax = 40;   // 20 seconds
 			break;
+
+		#ifdef ENABLE_PANADAPTER
+			case MENU_PAN_REVISIT:
+				*pMin = 0;
+				*pMax = ARRAY_SIZE(g_sub_menu_pan_revisit) - 1;
+				break;
+		#endif
+
+		#ifdef ENABLE_PRIORITY_LOOK_BACK
+			case MENU_PRI_LOOK_BACK:
+				*pMin = 0;    // off
+				*pMax = 50;   // 5 seconds
+				break;
+		#endif
+
+		#ifdef ENABLE_SCAN_LOG
+			case MENU_SCAN_LOG:
+				*pMin = 0;    // the latest hit
+				*pMax = (SCAN_LOG_count() > 0) ? SCAN_LOG_count() - 1 : 0;
+				break;
+		#endif
 			
 		case MENU_CROSS_VFO:
 			*pMin = 0;
@@ -374,6 +401,13 @@ int MENU_GetLimits(uint8_t Cursor, int32_t *pMin, int32_t *pMax)
 				break;
 		#endif
 
+		#ifdef ENABLE_AM_FIX
+			case MENU_AM_FIX_CAL:
+				*pMin = -AM_FIX_RSSI_CAL_MAX;
+				*pMax = +AM_FIX_RSSI_CAL_MAX;
+				break;
+		#endif
+
 		case MENU_BAT_CAL:
 			*pMin = 1600;  // 0
 			*pMax = 2200;  // 2300
@@ -539,6 +573,8 @@ void MENU_AcceptSetting(void)
 				t_channel_name    *chan_name = &g_eeprom.config.channel_name[chan];
 				int                i;
 
+				SETTINGS_need_channel(chan);
+
 				// trailing trim
 				for (i = 9; i >= 0; i--)
 				{
@@ -600,6 +636,12 @@ void MENU_AcceptSetting(void)
 			g_eeprom.config.setting.scan_hold_time = g_sub_menu_selection;
 			break;
 
+		#ifdef ENABLE_PRIORITY_LOOK_BACK
+			case MENU_PRI_LOOK_BACK:
+				g_eeprom.config.setting.priority_look_back = g_sub_menu_selection;
+				break;
+		#endif
+
 		case MENU_CROSS_VFO:
 			if (IS_NOAA_CHANNEL(g_eeprom.config.setting.indices.vfo[0].screen))
 				return;
@@ -680,6 +722,10 @@ void MENU_AcceptSetting(void)
 			case MENU_PANADAPTER:
 				g_eeprom.config.setting.panadapter = g_sub_menu_selection;
 				break;
+
+			case MENU_PAN_REVISIT:
+				g_eeprom.config.setting.panadapter_revisit = g_sub_menu_selection;
+				break;
 		#endif
 
 		#ifdef ENABLE_TX_AUDIO_BAR
@@ -890,6 +936,13 @@ void MENU_AcceptSetting(void)
 				return;
 #endif
 
+#ifdef ENABLE_AM_FIX
+		case MENU_AM_FIX_CAL:
+			g_eeprom.calib.am_fix_rssi_cal[g_current_vfo->channel_attributes.band] = AM_FIX_RSSI_CAL_NONE + g_sub_menu_selection;
+			EEPROM_WriteBuffer8(0x1F90, g_eeprom.calib.am_fix_rssi_cal);
+			return;
+#endif
+
 		case MENU_BAT_CAL:
 		{
 			g_eeprom.calib.battery[0] = (520ul * g_sub_menu_selection) / 760;  // 5.20V empty, blinking above this value, reduced functionality below
@@ -1095,6 +1148,18 @@ void MENU_ShowCurrentSetting(void)
 			g_sub_menu_selection = g_eeprom.config.setting.scan_hold_time;
 			break;
 
+		#ifdef ENABLE_PRIORITY_LOOK_BACK
+			case MENU_PRI_LOOK_BACK:
+				g_sub_menu_selection = g_eeprom.config.setting.priority_look_back;
+				break;
+		#endif
+
+		#ifdef ENABLE_SCAN_LOG
+			case MENU_SCAN_LOG:
+				g_sub_menu_selection = 0;
+				break;
+		#endif
+
 		case MENU_CROSS_VFO:
 			g_sub_menu_selection = g_eeprom.config.setting.cross_vfo;
 			break;
@@ -1157,6 +1222,10 @@ void MENU_ShowCurrentSetting(void)
 			case MENU_PANADAPTER:
 				g_sub_menu_selection = g_eeprom.config.setting.panadapter;
 				break;
+
+			case MENU_PAN_REVISIT:
+				g_sub_menu_selection = g_eeprom.config.setting.panadapter_revisit;
+				break;
 		#endif
 
 		#ifdef ENABLE_TX_AUDIO_BAR
@@ -1357,6 +1426,12 @@ void MENU_ShowCurrentSetting(void)
 				break;
 		#endif
 
+		#ifdef ENABLE_AM_FIX
+			case MENU_AM_FIX_CAL:
+				g_sub_menu_selection = AM_fix_rssi_cal(g_current_vfo->channel_attributes.band);
+				break;
+		#endif
+
 		case MENU_BAT_CAL:
 			g_sub_menu_selection = g_eeprom.calib.battery[3];
 			break;
@@ -1741,6 +1816,8 @@ static void MENU_Key_MENU(const bool key_pressed, const bool key_held)
 
 						MENU_AcceptSetting();
 
+						EEPROM_flush();
+
 						#if defined(ENABLE_OVERLAY)
 							overlay_FLASH_RebootToBootloader();
 						#else
@@ -2035,6 +2112,9 @@ void MENU_process_key(key_code_t Key, bool key_pressed, bool key_held)
 		if (g_menu_cursor == MENU_VOLTAGE ||
 #ifdef ENABLE_F_CAL_MENU
 			g_menu_cursor == MENU_F_CALI ||
+#endif
+#ifdef ENABLE_AM_FIX
+			g_menu_cursor == MENU_AM_FIX_CAL ||
 #endif
 			g_menu_cursor == MENU_BAT_CAL)
 		{
@@ -14,7 +14,7 @@
  *     limitations under the License.
  */
 
-#include <stdlib.h>  // abs()
+#include <string.h>
 
 #include "app/dtmf.h"
 #include "app/generic.h"
@@ -45,7 +45,7 @@ bool                g_search_flag_stop_scan;
 uint8_t             g_search_show_chan_prefix;
 
 bool                g_search_single_frequency;
-uint8_t             g_search_hit_count;
+search_vote_t       g_search_vote[SEARCH_VOTE_CANDIDATES];
 
 uint16_t            g_search_freq_css_tick_10ms;
 uint16_t            g_search_tick_10ms;
@@ -56,6 +56,50 @@ uint8_t             g_search_channel;
 uint32_t            g_search_frequency;
 step_setting_t      g_search_step_setting;
 
+static void SEARCH_vote_clear(void)
+{
+	memset(g_search_vote, 0, sizeof(g_search_vote));
+}
+
+static bool SEARCH_vote(const bool valid, const uint32_t value, const uint32_t tolerance)
+{	// count one search result, true once a candidate's won .. an invalid result is a vote for nobody
+	unsigned int i;
+
+	for (i = 0; i < ARRAY_SIZE(g_search_vote); i++)
+		g_search_vote[i].score -= (g_search_vote[i].score + 3) / 4;
+
+	if (valid)
+	{
+		search_vote_t *p_vote = NULL;
+
+		for (i = 0; i < ARRAY_SIZE(g_search_vote) && p_vote == NULL; i++)
+		{
+			const uint32_t delta = (value > g_search_vote[i].value) ? value - g_search_vote[i].value : g_search_vote[i].value - value;
+			if (g_search_vote[i].score > 0 && delta <= tolerance)
+				p_vote = &g_search_vote[i];
+		}
+
+		if (p_vote == NULL)
+		{	// a new candidate, it replaces the weakest
+			p_vote        = &g_search_vote[ARRAY_SIZE(g_search_vote) - 1];
+			p_vote->score = 0;
+		}
+
+		p_vote->value  = value;    // follow the latest result
+		p_vote->score += SEARCH_VOTE_WEIGHT;
+
+		// keep them best first
+		for (i = (unsigned int)(p_vote - g_search_vote); i > 0 && g_search_vote[i].score > g_search_vote[i - 1].score; i--)
+		{
+			const search_vote_t vote = g_search_vote[i];
+			g_search_vote[i]         = g_search_vote[i - 1];
+			g_search_vote[i - 1]     = vote;
+		}
+	}
+
+	return g_search_vote[0].score >= SEARCH_VOTE_WIN && g_search_vote[0].score >= (g_search_vote[1].score * 2);
+}
+
 static void SEARCH_Key_DIGITS(key_code_t Key, bool key_pressed, bool key_held)
 {
 	if (key_pressed)
@@ -387,7 +431,7 @@ void SEARCH_process_key(key_code_t Key, bool key_pressed, bool key_held)
 void SEARCH_process(void)
 {
 	uint32_t                 result;
-	int32_t                  delta;
+	bool                     found;
 	uint16_t                 ctcss_freq;
 	BK4819_CSS_scan_result_t scan_result;
 
@@ -433,28 +477,27 @@ void SEARCH_process(void)
 			if (!BK4819_GetFrequencyScanResult(&result))
 				break;   // still scanning
 
-			// accept only within 1kHz
-			delta = result - g_search_frequency;
-			g_search_hit_count = (abs(delta) < 100) ? g_search_hit_count + 1 : 0;
-
 			BK4819_DisableFrequencyScan();
 
-			g_search_frequency = result;
+			// results within 1kHz are votes for the same carrier
+			found = SEARCH_vote(true, result, 99);
+
+			g_search_frequency = g_search_vote[0].value;    // the leader so far
 
-			if (g_search_hit_count < 3)
+			if (!found)
 			{	// keep scanning for an RF carrier
 				BK4819_EnableFrequencyScan();
+				g_update_display = true;
 			}
 			else
-			{	// 3 matching consecutive results
-				//
-				// RF carrier found, move on to CTCSS/CDCSS search
+			{	// RF carrier found, move on to CTCSS/CDCSS search
 
 				BK4819_set_scan_frequency(g_search_frequency);
 
+				SEARCH_vote_clear();
+
 				g_search_css_result_type    = CODE_TYPE_NONE;
 				g_search_css_result_code    = 0xff;
-				g_search_hit_count          = 0;
 				g_search_use_css_result     = false;
 				g_search_freq_css_tick_10ms = 0;
 				g_search_css_state          = SEARCH_CSS_STATE_SCANNING;
@@ -474,7 +517,6 @@ void SEARCH_process(void)
 
 				#if defined(ENABLE_CODE_SEARCH_TIMEOUT)
 					g_search_css_state       = SEARCH_CSS_STATE_FAILED;
-//					g_search_hit_count       = 0;
 //					g_search_css_result_type = CODE_TYPE_NONE;
 //					g_search_css_result_code = 0xff;
 //					g_search_use_css_result  = false;
@@ -512,10 +554,15 @@ void SEARCH_process(void)
 			if (scan_result == BK4819_CSS_RESULT_CDCSS)
 			{	// found a CDCSS code
 
+				// the Golay check makes a decoded code good enough to go on by itself
+
 				const uint8_t code = DCS_GetCdcssCode(result);
-				if (code != 0xFF)
+				if (code == 0xFF)
+				{
+					SEARCH_vote(false, 0, 0);    // counts against any CTCSS candidates
+				}
+				else
 				{
-					g_search_hit_count       = 0;
 					g_search_css_result_type = CODE_TYPE_DIGITAL;
 					g_search_css_result_code = code;
 					g_search_css_state       = SEARCH_CSS_STATE_FOUND;
@@ -526,51 +573,32 @@ void SEARCH_process(void)
 					g_update_status  = true;
 					g_update_display = true;
 				}
-				else
-				{
-					g_search_hit_count       = 0;
-					g_search_css_result_type = CODE_TYPE_NONE;
-					g_search_css_result_code = 0xff;
-					g_search_use_css_result  = false;
-				}
 			}
 			else
 			if (scan_result == BK4819_CSS_RESULT_CTCSS)
 			{	// found a CTCSS tone
 
 				const uint8_t code = DCS_GetCtcssCode(ctcss_freq);
-				if (code != 0xFF)
-				{
-					if (code == g_search_css_result_code && g_search_css_result_type == CODE_TYPE_CONTINUOUS_TONE)
-					{	// same code
 
-						if (++g_search_hit_count >= 3)
-						{	// 3 matching consecutive results
+				found = SEARCH_vote(code != 0xFF, code, 0);
 
-							g_search_css_state      = SEARCH_CSS_STATE_FOUND;
-							g_search_use_css_result = true;
+				if (g_search_vote[0].score > 0)
+				{	// show the leader so far
+					g_search_css_result_type = CODE_TYPE_CONTINUOUS_TONE;
+					g_search_css_result_code = g_search_vote[0].value;
+				}
 
-							AUDIO_PlayBeep(BEEP_880HZ_60MS_TRIPLE_BEEP);
+				if (found)
+				{
+					g_search_css_state      = SEARCH_CSS_STATE_FOUND;
+					g_search_use_css_result = true;
 
-							g_update_status  = true;
-							g_update_display = true;
-						}
-					}
-					else
-					{	// reset
-						g_search_hit_count       = 1;
-						g_search_css_result_type = CODE_TYPE_CONTINUOUS_TONE;
-						g_search_css_result_code = code;
-						g_search_use_css_result  = false;
-					}
-				}
-				else
-				{	// reset
-					g_search_hit_count       = 0;
-					g_search_css_result_type = CODE_TYPE_NONE;
-					g_search_css_result_code = 0xff;
-					g_search_use_css_result  = false;
+					AUDIO_PlayBeep(BEEP_880HZ_60MS_TRIPLE_BEEP);
+
+					g_update_status = true;
 				}
+
+				g_update_display = true;
 			}
 
 			if (g_search_css_state == SEARCH_CSS_STATE_OFF || g_search_css_state == SEARCH_CSS_STATE_SCANNING)
@@ -664,13 +692,14 @@ void SEARCH_Start(void)
 	g_squelch_open              = false;
 	g_search_css_result_type    = CODE_TYPE_NONE;
 	g_search_css_result_code    = 0xff;
-	g_search_hit_count          = 0;
 	g_search_use_css_result     = false;
 	g_search_edit_state         = SEARCH_EDIT_STATE_NONE;
 	g_search_freq_css_tick_10ms = 0;
 	g_search_tick_10ms          = search_10ms;
 //	g_search_flag_start_scan    = false;
 
+	SEARCH_vote_clear();
+
 	g_request_display_screen = DISPLAY_SEARCH;
 	g_update_status          = true;
 }
@@ -39,6 +39,19 @@ enum search_edit_state_e {
 };
 typedef enum search_edit_state_e search_edit_state_t;
 
+// frequency and CTCSS search results are voted on .. every result first takes a quarter
+// off each candidate's score, then adds SEARCH_VOTE_WEIGHT to the one it matches. The
+// leader wins once it's score reaches SEARCH_VOTE_WIN with at least twice the runner up's,
+// so odd bad results on a weak or fading signal only slow it down rather than restart it
+#define SEARCH_VOTE_CANDIDATES  4
+#define SEARCH_VOTE_WEIGHT      16
+#define SEARCH_VOTE_WIN         32
+
+typedef struct {
+	uint32_t value;    // 10Hz units for a frequency, CTCSS_TONE_LIST index for a tone
+	uint8_t  score;    // 0 = unused
+} search_vote_t;
+
 extern search_css_state_t  g_search_css_state;
 extern dcs_code_type_t     g_search_css_result_type;
 extern uint8_t             g_search_css_result_code;
@@ -52,7 +65,7 @@ extern uint32_t            g_search_frequency;
 extern step_setting_t      g_search_step_setting;
 extern uint16_t            g_search_freq_css_tick_10ms;
 extern uint16_t            g_search_tick_10ms;
-extern uint8_t             g_search_hit_count;
+extern search_vote_t       g_search_vote[SEARCH_VOTE_CANDIDATES];   // best first
 extern bool                g_search_use_css_result;
 
 void SEARCH_process_key(key_code_t Key, bool key_pressed, bool key_held);
@@ -0,0 +1,379 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifdef ENABLE_SPECTRUM
+
+#include <string.h>
+
+#include "ARMCM0.h"
+#include "app/spectrum.h"
+#ifdef ENABLE_UART
+	#include "app/uart.h"
+#endif
+#include "bsp/dp32g030/gpio.h"
+#include "driver/backlight.h"
+#include "driver/bk4819.h"
+#include "driver/gpio.h"
+#include "driver/keyboard.h"
+#include "driver/st7565.h"
+#include "driver/system.h"
+#include "external/printf/printf.h"
+#include "frequencies.h"
+#include "functions.h"
+#include "misc.h"
+#include "radio.h"
+#include "settings.h"
+#include "ui/helper.h"
+
+// bin spacing for each zoom level, 10Hz units .. the span is 128 of these
+static const uint32_t spectrum_step[] = {625, 1250, 2500, 5000, 10000, 25000, 50000, 100000};
+
+// 4x4 ordered dither thresholds, gives the 1-bit waterfall 16 grey levels
+static const uint8_t spectrum_bayer[4][4] = {
+	{ 0,  8,  2, 10},
+	{12,  4, 14,  6},
+	{ 3, 11,  1,  9},
+	{15,  7, 13,  5}
+};
+
+#define SPECTRUM_BAR_HEIGHT   24   // pixels, frame buffer lines 1 to 3
+#define SPECTRUM_MIN_RANGE    40   // RSSI units (0.5dB) the display is scaled to at least
+
+static uint8_t  spectrum_peak[SPECTRUM_BINS];     // peak hold, 0 = bin not measured
+static uint16_t spectrum_avg_x4[SPECTRUM_BINS];   // running average x4, 0 = bin not measured
+
+static uint32_t     spectrum_center;
+static unsigned int spectrum_zoom;
+static unsigned int spectrum_cursor;
+static unsigned int spectrum_sweeps;
+
+static uint32_t SPECTRUM_bin_freq(const unsigned int bin)
+{
+	return spectrum_center + (((int32_t)bin - (SPECTRUM_BINS / 2)) * (int32_t)spectrum_step[spectrum_zoom]);
+}
+
+static void SPECTRUM_clear(void)
+{	// new span, start the peaks, averages and waterfall over
+	memset(spectrum_peak,   0, sizeof(spectrum_peak));
+	memset(spectrum_avg_x4, 0, sizeof(spectrum_avg_x4));
+	memset(g_frame_buffer[4], 0, sizeof(g_frame_buffer[0]) * 3);
+	spectrum_sweeps = 0;
+}
+
+static void SPECTRUM_measure(const unsigned int bin)
+{
+	const uint32_t freq = SPECTRUM_bin_freq(bin);
+	uint16_t       rssi;
+
+	if (FREQUENCY_rx_freq_check(freq) < 0)
+		return;   // outside what the BK4819 can tune, leave the bin empty
+
+	BK4819_set_rf_frequency(freq, true);
+
+	// only touch the LNA's when the sweep crosses over from VHF to UHF or back
+	if (bin == 0 || (SPECTRUM_bin_freq(bin - 1) < rf_filter_transition_freq) != (freq < rf_filter_transition_freq))
+		BK4819_set_rf_filter_path(freq);
+
+	if (!BK4819_wait_rf_settled(SPECTRUM_SETTLE_TIMEOUT_US))
+		return;   // the synthesizer won't have settled in time, keep the bin's last reading
+
+	rssi = BK4819_GetRSSI();
+	if (rssi > 255)
+		rssi = 255;
+	if (rssi == 0)
+		rssi = 1;   // 0 means empty
+
+	if (spectrum_avg_x4[bin] == 0)
+		spectrum_avg_x4[bin] = rssi * 4;
+	else
+		spectrum_avg_x4[bin] += rssi - (spectrum_avg_x4[bin] / 4);
+
+	if (spectrum_peak[bin] < rssi)
+		spectrum_peak[bin] = rssi;
+}
+
+static void SPECTRUM_render(void)
+{
+	const unsigned int line  = spectrum_sweeps & 3u;
+	unsigned int       floor = 255;
+	unsigned int       top   = 0;
+	unsigned int       range;
+	unsigned int       i;
+	char               str[22];
+
+	// scale to the quietest bin and the highest peak
+	for (i = 0; i < SPECTRUM_BINS; i++)
+	{
+		if (spectrum_avg_x4[i] == 0)
+			continue;
+		if (floor > (spectrum_avg_x4[i] / 4))
+			floor = spectrum_avg_x4[i] / 4;
+		if (top < spectrum_peak[i])
+			top = spectrum_peak[i];
+	}
+	range = (top > floor && (top - floor) > SPECTRUM_MIN_RANGE) ? top - floor : SPECTRUM_MIN_RANGE;
+
+	for (i = 0; i < SPECTRUM_BINS; i++)
+	{
+		uint32_t bar  = 0;
+		uint32_t fall = g_frame_buffer[4][i] | ((uint32_t)g_frame_buffer[5][i] << 8) | ((uint32_t)g_frame_buffer[6][i] << 16);
+
+		// scroll the waterfall down a pixel, bit 0 is the top pixel
+		fall = (fall << 1) & 0xFFFFFFu;
+
+		if (spectrum_avg_x4[i] > 0)
+		{
+			const unsigned int avg    = spectrum_avg_x4[i] / 4;
+			const unsigned int level  = (avg > floor) ? avg - floor : 0;
+			const unsigned int peak   = (spectrum_peak[i] > floor) ? spectrum_peak[i] - floor : 0;
+			unsigned int       height = (level * SPECTRUM_BAR_HEIGHT) / range;
+			unsigned int       dot    = (peak * SPECTRUM_BAR_HEIGHT) / range;
+
+			if (height > SPECTRUM_BAR_HEIGHT)
+				height = SPECTRUM_BAR_HEIGHT;
+			if (dot >= SPECTRUM_BAR_HEIGHT)
+				dot = SPECTRUM_BAR_HEIGHT - 1;
+
+			bar  = (0xFFFFFFu << (SPECTRUM_BAR_HEIGHT - height)) & 0xFFFFFFu;
+			bar |= 1u << (SPECTRUM_BAR_HEIGHT - 1 - dot);
+
+			// the new top pixel is the dithered average
+			if (((level * 16) / range) > spectrum_bayer[line][i & 3u])
+				fall |= 1u;
+		}
+
+		if (i == spectrum_cursor)
+			bar |= 0x492492u;   // dotted cursor line
+
+		g_frame_buffer[1][i] = (bar >>  0) & 0xFFu;
+		g_frame_buffer[2][i] = (bar >>  8) & 0xFFu;
+		g_frame_buffer[3][i] = (bar >> 16) & 0xFFu;
+		g_frame_buffer[4][i] = (fall >>  0) & 0xFFu;
+		g_frame_buffer[5][i] = (fall >>  8) & 0xFFu;
+		g_frame_buffer[6][i] = (fall >> 16) & 0xFFu;
+	}
+
+	{	// span across the status line
+		const uint32_t span_khz = (spectrum_step[spectrum_zoom] * SPECTRUM_BINS) / 100;
+
+		memset(g_status_line, 0, sizeof(g_status_line));
+		if (span_khz < 10000)
+			sprintf(str, "%3u.%05u %4ukHz", spectrum_center / 100000, spectrum_center % 100000, span_khz);
+		else
+			sprintf(str, "%3u.%05u %4uMHz", spectrum_center / 100000, spectrum_center % 100000, span_khz / 1000);
+		UI_PrintStringSmallBuffer(str, g_status_line);
+	}
+
+	{	// cursor frequency and level on the top line
+		const uint32_t freq = SPECTRUM_bin_freq(spectrum_cursor);
+
+		memset(g_frame_buffer[0], 0, sizeof(g_frame_buffer[0]));
+		if (spectrum_avg_x4[spectrum_cursor] > 0)
+			sprintf(str, "%3u.%05u %4ddBm", freq / 100000, freq % 100000, (int)(spectrum_avg_x4[spectrum_cursor] / 8) - 160);
+		else
+			sprintf(str, "%3u.%05u  ----", freq / 100000, freq % 100000);
+		UI_PrintStringSmall(str, 0, 0, 0);
+	}
+
+	ST7565_BlitStatusLine();
+	ST7565_BlitFullScreen();
+}
+
+static bool SPECTRUM_tune_vfo(void)
+{	// put the VFO on the cursor, same as typing the frequency in
+	const unsigned int     vfo  = g_eeprom.config.setting.tx_vfo_num;
+	const uint32_t         freq = SPECTRUM_bin_freq(spectrum_cursor);
+	const frequency_band_t band = FREQUENCY_GetBand(freq);
+
+	if (!IS_FREQ_CHANNEL(g_tx_vfo->channel_save) || FREQUENCY_rx_freq_check(freq) < 0)
+		return false;
+
+	if (g_tx_vfo->channel_attributes.band != band)
+	{
+		g_tx_vfo->channel_attributes.band = band;
+		g_eeprom.config.setting.indices.vfo[vfo].screen    = band + FREQ_CHANNEL_FIRST;
+		g_eeprom.config.setting.indices.vfo[vfo].frequency = band + FREQ_CHANNEL_FIRST;
+
+		SETTINGS_save_vfo_indices();
+
+		RADIO_configure_channel(vfo, VFO_CONFIGURE_RELOAD);
+	}
+
+	g_tx_vfo->freq_config_rx.frequency = freq;
+	g_tx_vfo->freq_config_tx.frequency = freq;
+
+	// find the first channel that contains this frequency
+	g_tx_vfo->freq_in_channel = SETTINGS_find_channel(freq);
+
+	g_request_save_channel = 1;
+	g_vfo_configure_mode   = VFO_CONFIGURE;
+
+	return true;
+}
+
+static bool SPECTRUM_key(const key_code_t key)
+{	// returns true to leave
+	switch (key)
+	{
+		case KEY_UP:
+			spectrum_cursor = (spectrum_cursor + 1) % SPECTRUM_BINS;
+			break;
+
+		case KEY_DOWN:
+			spectrum_cursor = (spectrum_cursor + SPECTRUM_BINS - 1) % SPECTRUM_BINS;
+			break;
+
+		case KEY_2:    // pan up a quarter span
+		case KEY_8:    // pan down a quarter span
+			if (key == KEY_2)
+				spectrum_center += spectrum_step[spectrum_zoom] * (SPECTRUM_BINS / 4);
+			else
+				spectrum_center -= spectrum_step[spectrum_zoom] * (SPECTRUM_BINS / 4);
+			SPECTRUM_clear();
+			break;
+
+		case KEY_1:    // zoom out
+			if (spectrum_zoom < ARRAY_SIZE(spectrum_step) - 1)
+			{	// keep the cursor on the same frequency
+				spectrum_center = SPECTRUM_bin_freq(spectrum_cursor);
+				spectrum_zoom++;
+				spectrum_cursor = SPECTRUM_BINS / 2;
+				SPECTRUM_clear();
+			}
+			break;
+
+		case KEY_7:    // zoom in
+			if (spectrum_zoom > 0)
+			{
+				spectrum_center = SPECTRUM_bin_freq(spectrum_cursor);
+				spectrum_zoom--;
+				spectrum_cursor = SPECTRUM_BINS / 2;
+				SPECTRUM_clear();
+			}
+			break;
+
+		case KEY_0:    // reset the peak hold
+			memset(spectrum_peak, 0, sizeof(spectrum_peak));
+			break;
+
+		case KEY_MENU:
+			return SPECTRUM_tune_vfo();
+
+		case KEY_EXIT:
+			return true;
+
+		default:
+			break;
+	}
+
+	return false;
+}
+
+void APP_RunSpectrum(void)
+{
+	unsigned int debounce = 0;
+	key_code_t   key_prev = KEY_INVALID;
+	unsigned int bin      = 0;
+
+	// whatever was pressed to get us here has to be let go of first
+	while (KEYBOARD_Poll() != KEY_INVALID)
+		SYSTEM_DelayMs(10);
+
+	FUNCTION_Select(FUNCTION_PANADAPTER);
+
+	g_monitor_enabled = false;
+	GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_SPEAKER);
+	BK4819_SetAF(BK4819_AF_MUTE);
+	BK4819_write_reg(0x3F, 0);   // no interrupts while we're sweeping
+
+	BACKLIGHT_turn_on(0);
+
+	spectrum_center = g_tx_vfo->p_rx->frequency;
+	spectrum_cursor = SPECTRUM_BINS / 2;
+	for (spectrum_zoom = 0; spectrum_zoom < ARRAY_SIZE(spectrum_step) - 1; spectrum_zoom++)
+		if (spectrum_step[spectrum_zoom] >= g_tx_vfo->step_freq)
+			break;
+
+	memset(g_frame_buffer, 0, sizeof(g_frame_buffer));
+	SPECTRUM_clear();
+
+	while (1)
+	{
+		// one bin per pass, so the keys get a look in at least every settle timeout
+		SPECTRUM_measure(bin);
+
+		if (++bin >= SPECTRUM_BINS)
+		{
+			bin = 0;
+			SPECTRUM_render();
+			spectrum_sweeps++;
+		}
+
+		if (!g_next_time_slice)
+			continue;
+		g_next_time_slice = false;
+
+		if (!GPIO_CheckBit(&GPIOC->DATA, GPIOC_PIN_PTT))
+			break;
+
+		{
+			const key_code_t key = KEYBOARD_Poll();
+
+			if (key != key_prev)
+			{
+				debounce = 0;
+				key_prev = key;
+			}
+			else
+			if (key != KEY_INVALID && debounce < 0xFFFF)
+			{
+				if (++debounce == key_debounce_10ms)
+				{
+					if (SPECTRUM_key(key))
+						break;
+				}
+				else
+				if ((key == KEY_UP || key == KEY_DOWN) && debounce >= key_long_press_10ms)
+				{	// auto-repeat the cursor
+					if (((debounce - key_long_press_10ms) % key_repeat_10ms) == 0)
+						SPECTRUM_key(key);
+				}
+			}
+		}
+
+		#ifdef ENABLE_UART
+			if (UART_IsCommandAvailable())
+			{
+				__disable_irq();
+				UART_HandleCommand();
+				__enable_irq();
+			}
+		#endif
+	}
+
+	while (KEYBOARD_Poll() != KEY_INVALID)
+		SYSTEM_DelayMs(10);
+
+	BK4819_write_reg(0x02, 0);   // throw away anything the sweep caused
+
+	FUNCTION_Select(FUNCTION_FOREGROUND);
+	RADIO_setup_registers(true);
+
+	g_update_status  = true;
+	g_update_display = true;
+}
+
+#endif
@@ -0,0 +1,16 @@
+
+#ifndef APP_SPECTRUM_H
+#define APP_SPECTRUM_H
+
+#ifdef ENABLE_SPECTRUM
+	// bins across the screen, one pixel column each
+	#define SPECTRUM_BINS   128
+
+	// longest we wait for the synthesizer to settle on each bin, the widest span
+	// jumps over 10MHz going back to bin 0, which needs the longest settle time
+	#define SPECTRUM_SETTLE_TIMEOUT_US   2000
+
+	void APP_RunSpectrum(void);
+#endif
+
+#endif
@@ -16,6 +16,8 @@
 
 #define INCLUDE_AES
 
+#include <stddef.h>     // offsetof
+
 #if !defined(ENABLE_OVERLAY)
 	#include "ARMCM0.h"
 #endif
@@ -31,12 +33,22 @@
 #include "driver/crc.h"
 #include "driver/eeprom.h"
 #include "driver/gpio.h"
+#ifdef ENABLE_SCAN_IGNORE_LIST
+	#include "freq_ignore.h"
+#endif
 #if defined(ENABLE_UART)
 	#include "driver/uart.h"
 #endif
 #include "functions.h"
+#include "helper/boot.h"
 #include "misc.h"
+#ifdef ENABLE_PROFILER
+	#include "profile.h"
+#endif
 #include "radio.h"
+#ifdef ENABLE_SCAN_LOG
+	#include "scan_log.h"
+#endif
 #include "settings.h"
 #if defined(ENABLE_OVERLAY)
 	#include "sram-overlay.h"
@@ -111,6 +123,31 @@ typedef struct {
 	} __attribute__((packed)) Data;
 } __attribute__((packed)) reply_051D_t;
 
+#ifdef ENABLE_PROFILER
+	typedef struct {
+		Header_t Header;
+		uint8_t  section;
+		uint8_t  reset;         // clear all the stats after replying
+		uint8_t  pad[2];
+	} __attribute__((packed)) cmd_0525_t;
+
+	typedef struct {
+		Header_t Header;
+		struct {
+			uint8_t  section;
+			uint8_t  section_count;
+			uint8_t  pad[2];
+			uint32_t overruns;
+			uint32_t missed_ticks;
+			uint32_t count;
+			uint32_t min_cycles;
+			uint32_t max_cycles;
+			uint32_t avg_cycles;
+			uint16_t hist[PROFILE_HIST_BUCKETS];
+		} __attribute__((packed)) Data;
+	} __attribute__((packed)) reply_0525_t;
+#endif
+
 typedef struct {
 	Header_t Header;
 	struct {
@@ -146,6 +183,36 @@ typedef struct {
 	uint32_t time_stamp;
 } __attribute__((packed)) cmd_052F_t;
 
+typedef struct {
+	Header_t Header;
+	struct {
+		uint8_t  phase_count;
+		uint8_t  pad[3];
+		uint32_t time_us[BOOT_PHASE_COUNT];   // see boot_phase_t, 0 = not reached yet
+	} __attribute__((packed)) Data;
+} __attribute__((packed)) reply_0531_t;
+
+#ifdef ENABLE_SCAN_LOG
+	typedef struct {
+		Header_t Header;
+		uint8_t  index;         // first entry wanted, 0 = oldest
+		uint8_t  clear;         // empty the log after replying
+		uint8_t  pad[2];
+	} __attribute__((packed)) cmd_0533_t;
+
+	typedef struct {
+		Header_t Header;
+		struct {
+			uint8_t          index;       // of the first entry in this reply
+			uint8_t          count;       // entries in this reply
+			uint8_t          total;       // entries in the log
+			uint8_t          pad;
+			uint32_t         tick_10ms;   // g_global_sys_tick_counter now, to date the entries by
+			scan_log_entry_t entry[8];
+		} __attribute__((packed)) Data;
+	} __attribute__((packed)) reply_0534_t;
+#endif
+
 static union
 {
 	uint8_t Buffer[256];
@@ -332,13 +399,14 @@ static void cmd_051D(const uint8_t *pBuffer)
 	if (!locked)
 #endif
 	{
+		uint8_t     *p_data = (uint8_t *)pCmd + sizeof(cmd_051D_t);
 		unsigned int i;
 
 		for (i = 0; i < (size / write_size); i++)
 		{
 			const unsigned int k = i * write_size;
 			const unsigned int Offset = addr + k;
-			uint8_t *data = (uint8_t *)pCmd + sizeof(cmd_051D_t) + k;
+			uint8_t *data = p_data + k;
 
 			if ((Offset + write_size) > EEPROM_SIZE)
 				break;
@@ -360,15 +428,30 @@ static void cmd_051D(const uint8_t *pBuffer)
 			//#endif
 
 			#ifdef ENABLE_PWRON_PASSWORD
-				if ((Offset < 0x0E98 || Offset >= 0x0E9C) || !g_password_locked || pCmd->allow_password)
-					EEPROM_WriteBuffer8(Offset, data);
+				if ((Offset >= 0x0E98 && Offset < 0x0E9C) && g_password_locked && !pCmd->allow_password)
+					memcpy(data, ((uint8_t *)&g_eeprom) + Offset, write_size);   // leave it as it is
 			#else
 				if (Offset == 0x0E98)
 					memset(data, 0xff, 4);   // wipe the password 
-				EEPROM_WriteBuffer8(Offset, data);
 			#endif
 		}
 
+		// then write the lot in one go, it goes out to the chip in page writes
+		EEPROM_WriteBuffer(addr, p_data, i * write_size);
+
+		// the channel attributes or priority channels may have just changed
+		RADIO_build_scan_index();
+
+		#ifdef ENABLE_SCAN_IGNORE_LIST
+			FI_eeprom_written(addr, i * write_size);   // so has the ignore list
+		#endif
+
+		if (addr < (offsetof(t_eeprom, calib.squelch_band) + sizeof(g_eeprom.calib.squelch_band)) && (addr + (i * write_size)) > offsetof(t_eeprom, calib.squelch_band))
+			RADIO_build_squelch_table();   // and the squelch calibration
+
+		// the programming software expects the data to be on the chip when we reply
+		EEPROM_flush();
+
 		#ifdef INCLUDE_AES
 			if (reload_eeprom)
 				SETTINGS_read_eeprom();
@@ -378,6 +461,39 @@ static void cmd_051D(const uint8_t *pBuffer)
 	SendReply(&reply, sizeof(reply));
 }
 
+#ifdef ENABLE_PROFILER
+	// read the time slice profiler
+	static void cmd_0525(const uint8_t *pBuffer)
+	{
+		const cmd_0525_t      *pCmd = (const cmd_0525_t *)pBuffer;
+		const profile_stats_t *p;
+		reply_0525_t           reply;
+
+		if (pCmd->section >= PROFILE_SECTION_COUNT)
+			return;
+
+		p = &g_profile[pCmd->section];
+
+		memset(&reply, 0, sizeof(reply));
+		reply.Header.ID          = 0x0526;
+		reply.Header.Size        = sizeof(reply.Data);
+		reply.Data.section       = pCmd->section;
+		reply.Data.section_count = PROFILE_SECTION_COUNT;
+		reply.Data.overruns      = g_profile_overruns;
+		reply.Data.missed_ticks  = g_profile_missed_ticks;
+		reply.Data.count         = p->count;
+		reply.Data.min_cycles    = (p->count > 0) ? p->min_cycles : 0;
+		reply.Data.max_cycles    = p->max_cycles;
+		reply.Data.avg_cycles    = (p->count > 0) ? (uint32_t)(p->total_cycles / p->count) : 0;
+		memcpy(reply.Data.hist, p->hist, sizeof(reply.Data.hist));
+
+		SendReply(&reply, sizeof(reply));
+
+		if (pCmd->reset)
+			PROFILE_reset();
+	}
+#endif
+
 // read RSSI
 static void cmd_0527(void)
 {
@@ -492,6 +608,51 @@ static void cmd_052F(const uint8_t *pBuffer)
 	SendVersion();
 }
 
+// read the power-on timestamps
+static void cmd_0531(void)
+{
+	reply_0531_t reply;
+
+	memset(&reply, 0, sizeof(reply));
+	reply.Header.ID        = 0x0532;
+	reply.Header.Size      = sizeof(reply.Data);
+	reply.Data.phase_count = BOOT_PHASE_COUNT;
+	memcpy(reply.Data.time_us, g_boot_time_us, sizeof(reply.Data.time_us));
+
+	SendReply(&reply, sizeof(reply));
+}
+
+#ifdef ENABLE_SCAN_LOG
+	// read the scan activity log, up to 8 entries at a time
+	static void cmd_0533(const uint8_t *pBuffer)
+	{
+		const cmd_0533_t  *pCmd  = (const cmd_0533_t *)pBuffer;
+		const unsigned int total = SCAN_LOG_count();
+		unsigned int       count = 0;
+		reply_0534_t       reply;
+
+		memset(&reply, 0, sizeof(reply));
+
+		while (count < ARRAY_SIZE(reply.Data.entry) && (pCmd->index + count) < total)
+		{
+			reply.Data.entry[count] = *SCAN_LOG_entry(pCmd->index + count);
+			count++;
+		}
+
+		reply.Header.ID      = 0x0534;
+		reply.Header.Size    = sizeof(reply.Data) - sizeof(reply.Data.entry) + (count * sizeof(reply.Data.entry[0]));
+		reply.Data.index     = pCmd->index;
+		reply.Data.count     = count;
+		reply.Data.total     = total;
+		reply.Data.tick_10ms = g_global_sys_tick_counter;
+
+		SendReply(&reply, sizeof(reply.Header) + reply.Header.Size);
+
+		if (pCmd->clear)
+			SCAN_LOG_clear();
+	}
+#endif
+
 bool UART_IsCommandAvailable(void)
 {
 	uint16_t Index;
@@ -594,10 +755,12 @@ void UART_HandleCommand(void)
 			break;
 
 		case 0x051B:    // read eeprom
+			SETTINGS_load_deferred_all();
 			cmd_051B(UART_Command.Buffer);
 			break;
 
 		case 0x051D:    // write eeprom
+			SETTINGS_load_deferred_all();
 			cmd_051D(UART_Command.Buffer);
 			break;
 
@@ -607,6 +770,12 @@ void UART_HandleCommand(void)
 		case 0x0521:	// Not implementing non-authentic command
 			break;
 
+#ifdef ENABLE_PROFILER
+		case 0x0525:    // read profiler
+			cmd_0525(UART_Command.Buffer);
+			break;
+#endif
+
 		case 0x0527:    // read RSSI
 			cmd_0527();
 			break;
@@ -625,7 +794,18 @@ void UART_HandleCommand(void)
 			cmd_052F(UART_Command.Buffer);
 			break;
 
+		case 0x0531:    // read boot timestamps
+			cmd_0531();
+			break;
+
+#ifdef ENABLE_SCAN_LOG
+		case 0x0533:    // read scan log
+			cmd_0533(UART_Command.Buffer);
+			break;
+#endif
+
 		case 0x05DD:    // reboot
+			EEPROM_flush();
 			#if defined(ENABLE_OVERLAY)
 				overlay_FLASH_RebootToBootloader();
 			#else
@@ -66,26 +66,39 @@ uint32_t DCS_GetGolayCodeWord(dcs_code_type_t code_type, uint8_t Option)
 	return code;
 }
 
+static uint8_t DCS_lookup(const uint32_t Word)
+{	// DCS_CODE_LIST index if this is a valid codeword as it stands, 0xFF if not
+	//
+	//  <22:12> Golay parity
+	//   <11:9> 100
+	//    <8:0> code
+	//
+	uint8_t index;
+
+	if (((Word >> 9) & 0x7U) != 4)
+		return 0xFF;
+
+	index = dcs_code_index[Word & 0x1FF];
+	if (index == 0xFF || dcs_golay_parity[index] != (Word >> 12))
+		return 0xFF;
+
+	return index;
+}
+
 uint8_t DCS_GetCdcssCode(uint32_t Code)
-{
+{	// the received word can start at any of it's 23 bits .. no need to try it inverted
+	// as well, every inverted code turns up here as some rotation of a normal one
 	unsigned int i;
+
+	Code &= 0x7FFFFFU;
+
 	for (i = 0; i < 23; i++)
 	{
-		uint32_t Shift;
-
-		if (((Code >> 9) & 0x7U) == 4)
-		{
-			unsigned int j;
-			for (j = 0; j < ARRAY_SIZE(DCS_CODE_LIST); j++)
-				if (DCS_CODE_LIST[j] == (Code & 0x1FF))
-					if (DCS_GetGolayCodeWord(2, j) == Code)
-						return j;
-		}
+		const uint8_t index = DCS_lookup(Code);
+		if (index != 0xFF)
+			return index;
 
-		Shift = Code >> 1;
-		if (Code & 1U)
-			Shift |= 0x400000U;
-		Code = Shift;
+		Code = (Code >> 1) | ((Code & 1U) << 22);
 	}
 
 	return 0xFF;
@@ -37,6 +37,10 @@ enum {
 extern const uint16_t CTCSS_TONE_LIST[50];
 extern const uint16_t DCS_CODE_LIST[104];
 
+// generated at build time by utils/gen_tables.c
+extern const uint8_t  dcs_code_index[512];     // DCS_CODE_LIST index of each 9-bit code, 0xFF = not a code
+extern const uint16_t dcs_golay_parity[104];   // each code's 11 Golay parity bits, <22:12> of the codeword
+
 uint32_t DCS_GetGolayCodeWord(dcs_code_type_t code_type, uint8_t Option);
 uint8_t DCS_GetCdcssCode(uint32_t Code);
 uint8_t DCS_GetCtcssCode(int Code);
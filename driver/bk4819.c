@@ -33,8 +33,40 @@
 	#define ARRAY_SIZE(x) (sizeof(x) / sizeof(x[0]))
 #endif
 
+#define REG_BIT(reg)  (1u << ((reg) & 31u))
+
+// tone frequency (Hz) to frequency control word, for const register tables
+#define SCALE_FREQ(freq)    ((((uint32_t)(freq) * 338311u) + (1u << 14)) >> 15)
+
+// REG_52 CTCSS found/lost detect thresholds, no tail phase shift
+#define REG_52_SUB_AUDIBLE  ((0u << 15) | (0u << 13) | (0u << 12) | (10u << 6) | (15u << 0))   // 0x028F  0 00 0 001010 001111
+
 static uint16_t g_bk4819_gpio_out_state;
 
+// shadow copy of the registers, saves bit-banging out writes that wouldn't
+// change anything and reads of values we already know
+static uint16_t bk4819_reg_cache[128];
+static uint32_t bk4819_reg_cached[128 / 32];     // bit set = bk4819_reg_cache[] entry is valid
+
+// registers the chip changes by itself (status, FSK FIFO, indexed tables) .. never cached
+static const uint32_t bk4819_reg_volatile[128 / 32] = {
+	REG_BIT(0x00) | REG_BIT(0x01) | REG_BIT(0x02) | REG_BIT(0x06) | REG_BIT(0x08) | REG_BIT(0x09) |
+	REG_BIT(0x0B) | REG_BIT(0x0C) | REG_BIT(0x0D) | REG_BIT(0x0E),
+	0,
+	REG_BIT(0x59) | REG_BIT(0x5D) | REG_BIT(0x5E) | REG_BIT(0x5F),
+	REG_BIT(0x63) | REG_BIT(0x64) | REG_BIT(0x65) | REG_BIT(0x67) | REG_BIT(0x68) | REG_BIT(0x69) |
+	REG_BIT(0x6A) | REG_BIT(0x6F)
+};
+
+// registers where every write does something (re-triggers the chips RX/TX/VCO state
+// machines), these are cached for reads but always written
+static const uint32_t bk4819_reg_always_write[128 / 32] = {
+	0,
+	REG_BIT(0x30),
+	0,
+	0
+};
+
 //const uint32_t rf_filter_transition_freq = 28000000;  // original
   const uint32_t rf_filter_transition_freq = 26500000;
 
@@ -45,32 +77,11 @@ bool g_rx_idle_mode;
 __inline uint16_t scale_freq(const uint16_t freq)
 {	// with rounding
 //	return (((uint32_t)freq * 1032444u) + 50000u) / 100000u;
-	return (((uint32_t)freq * 338311u) + (1u << 14)) >> 15;    // max freq = 12695
+	return SCALE_FREQ(freq);    // max freq = 12695
 }
 
 void BK4819_Init(void)
 {
-	g_bk4819_gpio_out_state = 0x9000;
-
-	GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
-	GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-	GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
-
-	// reset the chip
-	BK4819_write_reg(0x00, (1u << 15));
-	BK4819_write_reg(0x00, 0);
-
-	BK4819_write_reg(0x37, 0x1D0F);
-	BK4819_write_reg(0x36, 0x0022);
-
-#ifdef ENABLE_AM_FIX
-	BK4819_DisableAGC();
-#else
-	BK4819_EnableAGC();  // only do this in linear modulation modes, not FM
-#endif
-
-	BK4819_set_mic_gain(31);
-
 	// REG_48 .. RX AF level
 	//
 	// <15:12> 11  ???  0 to 15
@@ -89,29 +100,67 @@ void BK4819_Init(void)
 	//         15 = max
 	//          0 = min
 	//
-	BK4819_write_reg(0x48,	//  0xB3A8);     // 1011 00 111010 1000
-		(11u << 12) |     // ??? 0..15
-		( 0u << 10) |     // AF Rx Gain-1
-		(58u <<  4) |     // AF Rx Gain-2
-		( 8u <<  0));     // AF DAC Gain (after Gain-1 and Gain-2)
+	static const bk4819_reg_seq_t init_seq[] = {
+		BK4819_REG_SET(0x00, (1u << 15)),   // reset the chip
+		BK4819_REG_SET(0x00, 0),
+
+		BK4819_REG_SET(0x37, 0x1D0F),
+		BK4819_REG_SET(0x36, 0x0022),
+
+		BK4819_REG_SET(0x48,	//  0xB3A8);     // 1011 00 111010 1000
+			(11u << 12) |     // ??? 0..15
+			( 0u << 10) |     // AF Rx Gain-1
+			(58u <<  4) |     // AF Rx Gain-2
+			( 8u <<  0)),     // AF DAC Gain (after Gain-1 and Gain-2)
+
+		// squelch mode
+		BK4819_REG_SET(0x77, 0x88EF),     // rssi + noise + glitch .. RT-890
+//		BK4819_REG_SET(0x77, 0xA8EF),     // rssi + noise + glitch .. default
+//		BK4819_REG_SET(0x77, 0xAAEF),     // rssi + glitch
+//		BK4819_REG_SET(0x77, 0xCCEF),     // rssi + noise
+//		BK4819_REG_SET(0x77, 0xFFEF),     // rssi
+
+		// DTMF coefficients
+		BK4819_REG_SET(0x09, ( 0u << 12) | 111),
+		BK4819_REG_SET(0x09, ( 1u << 12) | 107),
+		BK4819_REG_SET(0x09, ( 2u << 12) | 103),
+		BK4819_REG_SET(0x09, ( 3u << 12) |  98),
+		BK4819_REG_SET(0x09, ( 4u << 12) |  80),
+		BK4819_REG_SET(0x09, ( 5u << 12) |  71),
+		BK4819_REG_SET(0x09, ( 6u << 12) |  58),
+		BK4819_REG_SET(0x09, ( 7u << 12) |  44),
+		BK4819_REG_SET(0x09, ( 8u << 12) |  65),
+		BK4819_REG_SET(0x09, ( 9u << 12) |  55),
+		BK4819_REG_SET(0x09, (10u << 12) |  37),
+		BK4819_REG_SET(0x09, (11u << 12) |  23),
+		BK4819_REG_SET(0x09, (12u << 12) | 228),
+		BK4819_REG_SET(0x09, (13u << 12) | 203),
+		BK4819_REG_SET(0x09, (14u << 12) | 181),
+		BK4819_REG_SET(0x09, (15u << 12) | 159),
+
+		BK4819_REG_SET(0x1F, 0x5454),  // 0101 0100 01 01 0100
+		BK4819_REG_SET(0x3E, 41015),   // band selection threshold = VCO max frequency (Hz) / 96 / 640
+		BK4819_REG_SET(0x33, 0x9000),  // 1001 0000 0000 0000 .. GPIO
+		BK4819_REG_SET(0x3F, 0)        // disable interrupts
+	};
 
-	// squelch mode
-	BK4819_write_reg(0x77, 0x88EF);     // rssi + noise + glitch .. RT-890
-//	BK4819_write_reg(0x77, 0xA8EF);     // rssi + noise + glitch .. default
-//	BK4819_write_reg(0x77, 0xAAEF);     // rssi + glitch
-//	BK4819_write_reg(0x77, 0xCCEF);     // rssi + noise
-//	BK4819_write_reg(0x77, 0xFFEF);     // rssi
+	g_bk4819_gpio_out_state = 0x9000;
 
-	BK4819_config_sub_audible();
+	GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
+	GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
+	GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
+
+	BK4819_write_regs(init_seq, ARRAY_SIZE(init_seq));
+
+#ifdef ENABLE_AM_FIX
+	BK4819_DisableAGC();
+#else
+	BK4819_EnableAGC();  // only do this in linear modulation modes, not FM
+#endif
 
-	const uint8_t dtmf_coeffs[] = {111, 107, 103, 98, 80, 71, 58, 44, 65, 55, 37, 23, 228, 203, 181, 159};
-	for (unsigned int i = 0; i < ARRAY_SIZE(dtmf_coeffs); i++)
-		BK4819_write_reg(0x09, (i << 12) | dtmf_coeffs[i]);
+	BK4819_set_mic_gain(31);
 
-	BK4819_write_reg(0x1F, 0x5454);  // 0101 0100 01 01 0100
-	BK4819_write_reg(0x3E, 41015);   // band selection threshold = VCO max frequency (Hz) / 96 / 640
-	BK4819_write_reg(0x33, 0x9000);  // 1001 0000 0000 0000 .. GPIO
-	BK4819_write_reg(0x3F, 0);       // disable interrupts
+	BK4819_config_sub_audible();
 
 #if 0
 	// RT-890
@@ -160,34 +209,124 @@ static uint16_t BK4819_read_16(void)
 	return Value;
 }
 
-uint16_t BK4819_read_reg(const uint8_t Register)
+static void BK4819_bus_start(void)
 {
-	uint16_t Value;
 	GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
 	GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
 	SYSTICK_Delay250ns(1);  // 4
+}
+
+static void BK4819_bus_idle(void)
+{
+	GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
+	GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
+}
+
+static void BK4819_bus_write(const uint8_t Register, const uint16_t Data)
+{	// one SCN framed register write, SCL is left low ready for the next one
+	GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
+	BK4819_write_8(Register);
+	BK4819_write_16(Data);
+	GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
+	SYSTICK_Delay250ns(1);  // 4
+}
+
+static bool BK4819_cache_write(const unsigned int reg, const uint16_t Data)
+{	// returns false if the write wouldn't change anything
+	const uint32_t     bit  = REG_BIT(reg);
+	const unsigned int word = reg >> 5;
+
+	if ((bk4819_reg_cached[word] & bit) && bk4819_reg_cache[reg] == Data && (bk4819_reg_always_write[word] & bit) == 0)
+		return false;
+
+	if (reg == 0x00 && (Data & (1u << 15)))
+		BK4819_invalidate_reg_cache();   // soft reset, everything goes back to it's default
+	else
+	if ((bk4819_reg_volatile[word] & bit) == 0)
+	{
+		bk4819_reg_cache[reg]    = Data;
+		bk4819_reg_cached[word] |= bit;
+	}
+
+	return true;
+}
+
+void BK4819_invalidate_reg_cache(void)
+{
+	memset(bk4819_reg_cached, 0, sizeof(bk4819_reg_cached));
+}
+
+uint16_t BK4819_read_reg(const uint8_t Register)
+{
+	const unsigned int reg  = Register & 0x7Fu;
+	const uint32_t     bit  = REG_BIT(reg);
+	const unsigned int word = reg >> 5;
+	uint16_t           Value;
+
+	if (bk4819_reg_cached[word] & bit)
+		return bk4819_reg_cache[reg];
+
+	BK4819_bus_start();
 	GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
 	BK4819_write_8(Register | 0x80);
 	Value = BK4819_read_16();
 	GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
 	SYSTICK_Delay250ns(1);  // 4
-	GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-	GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
+	BK4819_bus_idle();
+
+	if ((bk4819_reg_volatile[word] & bit) == 0)
+	{
+		bk4819_reg_cache[reg]    = Value;
+		bk4819_reg_cached[word] |= bit;
+	}
+
 	return Value;
 }
 
 void BK4819_write_reg(const uint8_t Register, uint16_t Data)
 {
-	GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
-	GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-	SYSTICK_Delay250ns(1);  // 4
-	GPIO_ClearBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
-	BK4819_write_8(Register);
-	BK4819_write_16(Data);
-	GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCN);
-	SYSTICK_Delay250ns(1);  // 4
-	GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SCL);
-	GPIO_SetBit(&GPIOC->DATA, GPIOC_PIN_BK4819_SDA);
+	if (!BK4819_cache_write(Register & 0x7Fu, Data))
+		return;   // no change
+
+	BK4819_bus_start();
+	BK4819_bus_write(Register, Data);
+	BK4819_bus_idle();
+}
+
+void BK4819_write_regs(const bk4819_reg_seq_t *seq, const unsigned int count)
+{	// the bus is only set up once and put back to idle once at the end, the
+	// registers go out back-to-back in their own SCN frames
+	bool         started = false;
+	unsigned int i;
+
+	for (i = 0; i < count; i++, seq++)
+	{
+		const uint8_t reg  = seq->reg & 0x7Fu;
+		uint16_t      Data = seq->value;
+
+		if (seq->mask != 0xFFFF)
+		{	// read-modify-write, a read that misses the cache needs the bus to itself
+			if (started)
+			{
+				BK4819_bus_idle();
+				started = false;
+			}
+			Data = (BK4819_read_reg(reg) & ~seq->mask) | (Data & seq->mask);
+		}
+
+		if (!BK4819_cache_write(reg, Data))
+			continue;   // no change
+
+		if (!started)
+		{
+			BK4819_bus_start();
+			started = true;
+		}
+		BK4819_bus_write(reg, Data);
+	}
+
+	if (started)
+		BK4819_bus_idle();
 }
 
 void BK4819_write_8(uint8_t Data)
@@ -535,8 +674,34 @@ void BK4819_SetupPowerAmplifier(const uint8_t bias, const uint32_t frequency)
 	BK4819_write_reg(0x36, ((uint16_t)bias << 8) | ((uint16_t)enable << 7) | ((uint16_t)gain << 0));
 }
 
+// RF settle time
+//
+// the BK4819 has no PLL lock flag or any other settle indication we know of, and the
+// RSSI register is filtered so it lags the synthesizer, so a retune is given a fixed
+// settle time that grows with the size of the jump .. bigger jumps have the VCO
+// calibration and the PLL a longer way to go
+//
+// these are estimates, not yet bench measured .. to measure one, put a steady carrier
+// on F, retune to F from F - step, and time how long the RSSI takes to get within 1dB
+// of where it sits 10ms later, then take the worst of a few runs either side of F
+static const struct {
+	uint32_t step;           // up to this far, in 10Hz units
+	uint16_t us;
+} rf_settle_time[] = {
+	{   2500u,  250},        // 25kHz, a channel step
+	{ 100000u,  500},        // 1MHz
+	{1000000u, 1000},        // 10MHz
+	{0xffffffff, 2000}       // anything further, or a band change
+};
+
+static uint32_t rf_frequency;   // last frequency the synthesizer was set to
+static uint32_t rf_step;        // and how far it moved to get there
+
 void BK4819_set_rf_frequency(const uint32_t frequency, const bool trigger_update)
 {
+	rf_step      = (rf_frequency == 0) ? 0xffffffff : (frequency > rf_frequency) ? frequency - rf_frequency : rf_frequency - frequency;
+	rf_frequency = frequency;
+
 	BK4819_write_reg(0x38, (frequency >>  0) & 0xFFFF);
 	BK4819_write_reg(0x39, (frequency >> 16) & 0xFFFF);
 
@@ -548,6 +713,20 @@ void BK4819_set_rf_frequency(const uint32_t frequency, const bool trigger_update
 	}
 }
 
+bool BK4819_wait_rf_settled(const unsigned int timeout_us)
+{	// waits out the settle time for the last retune, false straight away if that's longer than the timeout
+	unsigned int i = 0;
+
+	while (rf_step > rf_settle_time[i].step)
+		i++;
+
+	if (rf_settle_time[i].us > timeout_us)
+		return false;
+
+	SYSTICK_Delay250ns(rf_settle_time[i].us * 4);
+	return true;
+}
+
 void BK4819_SetupSquelch(
 		uint8_t squelch_open_rssi_thresh,
 		uint8_t squelch_close_rssi_thresh,
@@ -665,21 +844,25 @@ void BK4819_RX_TurnOn(void)
 	// Enable  XTAL
 	// Enable  Band Gap
 	//
-	BK4819_write_reg(0x37, 0x1F0F);  // 0001 1111 0000 1111
+	static const bk4819_reg_seq_t rx_on_seq[] = {
+		BK4819_REG_SET(0x37, 0x1F0F),  // 0001 1111 0000 1111
 
-	BK4819_write_reg(0x30, 0);
-	BK4819_write_reg(0x30,
-		BK4819_REG_30_ENABLE_VCO_CALIB |
-//		BK4819_REG_30_ENABLE_UNKNOWN   |
-		BK4819_REG_30_ENABLE_RX_LINK   |
-		BK4819_REG_30_ENABLE_AF_DAC    |
-		BK4819_REG_30_ENABLE_DISC_MODE |
-		BK4819_REG_30_ENABLE_PLL_VCO   |
-//		BK4819_REG_30_ENABLE_PA_GAIN   |
-//		BK4819_REG_30_ENABLE_MIC_ADC   |
-//		BK4819_REG_30_ENABLE_TX_DSP    |
-		BK4819_REG_30_ENABLE_RX_DSP    |
-	0);
+		BK4819_REG_SET(0x30, 0),
+		BK4819_REG_SET(0x30,
+			BK4819_REG_30_ENABLE_VCO_CALIB |
+//			BK4819_REG_30_ENABLE_UNKNOWN   |
+			BK4819_REG_30_ENABLE_RX_LINK   |
+			BK4819_REG_30_ENABLE_AF_DAC    |
+			BK4819_REG_30_ENABLE_DISC_MODE |
+			BK4819_REG_30_ENABLE_PLL_VCO   |
+//			BK4819_REG_30_ENABLE_PA_GAIN   |
+//			BK4819_REG_30_ENABLE_MIC_ADC   |
+//			BK4819_REG_30_ENABLE_TX_DSP    |
+			BK4819_REG_30_ENABLE_RX_DSP    |
+		0)
+	};
+
+	BK4819_write_regs(rx_on_seq, ARRAY_SIZE(rx_on_seq));
 }
 
 void BK4819_set_rf_filter_path(const uint32_t Frequency)
@@ -1090,24 +1273,32 @@ void BK4819_ExitBypass(void)
 */
 void BK4819_PrepareTransmit(void)
 {
-//	BK4819_ExitBypass();
-	BK4819_ExitTxMute();
+	static const bk4819_reg_seq_t tx_on_seq[] = {
+//		BK4819_ExitBypass();
 
-	BK4819_config_sub_audible();
+		// if DTMF is enabled when TX'ing, it changes the TX audio filtering ! .. 1of11
+		// so MAKE SURE that DTMF is disabled - until needed
+		BK4819_REG_SET(0x24, 0),
 
-	BK4819_write_reg(0x30, 0);
-	BK4819_write_reg(0x30,
-		BK4819_REG_30_ENABLE_VCO_CALIB |
-		BK4819_REG_30_ENABLE_UNKNOWN   |
-//		BK4819_REG_30_ENABLE_RX_LINK   |
-//		BK4819_REG_30_ENABLE_AF_DAC    |
-		BK4819_REG_30_ENABLE_DISC_MODE |
-		BK4819_REG_30_ENABLE_PLL_VCO   |
-		BK4819_REG_30_ENABLE_PA_GAIN   |
-		BK4819_REG_30_ENABLE_MIC_ADC   |
-		BK4819_REG_30_ENABLE_TX_DSP    |
-//		BK4819_REG_30_ENABLE_RX_DSP    |
-	0);
+		BK4819_REG_SET(0x50, 0x3B20),               // exit TX mute
+		BK4819_REG_SET(0x52, REG_52_SUB_AUDIBLE),
+
+		BK4819_REG_SET(0x30, 0),
+		BK4819_REG_SET(0x30,
+			BK4819_REG_30_ENABLE_VCO_CALIB |
+			BK4819_REG_30_ENABLE_UNKNOWN   |
+//			BK4819_REG_30_ENABLE_RX_LINK   |
+//			BK4819_REG_30_ENABLE_AF_DAC    |
+			BK4819_REG_30_ENABLE_DISC_MODE |
+			BK4819_REG_30_ENABLE_PLL_VCO   |
+			BK4819_REG_30_ENABLE_PA_GAIN   |
+			BK4819_REG_30_ENABLE_MIC_ADC   |
+			BK4819_REG_30_ENABLE_TX_DSP    |
+//			BK4819_REG_30_ENABLE_RX_DSP    |
+		0)
+	};
+
+	BK4819_write_regs(tx_on_seq, ARRAY_SIZE(tx_on_seq));
 }
 
 void BK4819_Conditional_RX_TurnOn(void)
@@ -1298,7 +1489,7 @@ void BK4819_config_sub_audible(void)
 //		BK4819_gen_tail(2);    // 180 deg
 //	#else
 //		BK4819_gen_tail(4);
-		BK4819_write_reg(0x52, (0u << 15) | (0u << 13) | (0u << 12) | (10u << 6) | (15u << 0)); // 0x028F);  // 0 00 0 001010 001111
+		BK4819_write_reg(0x52, REG_52_SUB_AUDIBLE);
 //	#endif
 }
 
@@ -1736,27 +1927,37 @@ uint8_t BK4819_GetCTCType(void)
 	return (BK4819_read_reg(0x0C) >> 10) & 3u;
 }
 
-void BK4819_reset_fsk(void)
+bool BK4819_is_squelch_open(void)
 {
-	const uint16_t fsk_reg59 =
-		(0u << 15) |   // 0 or 1   1 = clear TX FIFO
-		(0u << 14) |   // 0 or 1   1 = clear RX FIFO
-		(0u << 13) |   // 0 or 1   1 = scramble
-		(0u << 12) |   // 0 or 1   1 = enable RX
-		(0u << 11) |   // 0 or 1   1 = enable TX
-		(0u << 10) |   // 0 or 1   1 = invert data when RX
-		(0u <<  9) |   // 0 or 1   1 = invert data when TX
-		(0u <<  8) |   // 0 or 1   ???
-		(6u <<  4) |   // 0 ~ 15   preamble Length Selection
-		(1u <<  3) |   // 0 or 1   sync length selection
-		(0u <<  0);    // 0 ~ 7    ???
+	return (BK4819_read_reg(0x0C) >> 1) & 1u;
+}
 
-	BK4819_write_reg(0x3F, 0);  // disable interrupts
+// REG_59 after an FSK reset
+//
+//   (0u << 15) |   // 0 or 1   1 = clear TX FIFO
+//   (0u << 14) |   // 0 or 1   1 = clear RX FIFO
+//   (0u << 13) |   // 0 or 1   1 = scramble
+//   (0u << 12) |   // 0 or 1   1 = enable RX
+//   (0u << 11) |   // 0 or 1   1 = enable TX
+//   (0u << 10) |   // 0 or 1   1 = invert data when RX
+//   (0u <<  9) |   // 0 or 1   1 = invert data when TX
+//   (0u <<  8) |   // 0 or 1   ???
+//   (6u <<  4) |   // 0 ~ 15   preamble Length Selection
+//   (1u <<  3) |   // 0 or 1   sync length selection
+//   (0u <<  0);    // 0 ~ 7    ???
+//
+#define FSK_RESET_REG59  ((6u << 4) | (1u << 3))
 
-	BK4819_write_reg(0x59, (1u << 15) | (1u << 14) | fsk_reg59); // clear FIFO's
-	BK4819_write_reg(0x59, fsk_reg59);
+void BK4819_reset_fsk(void)
+{
+	static const bk4819_reg_seq_t fsk_reset_seq[] = {
+		BK4819_REG_SET(0x3F, 0),                                         // disable interrupts
+		BK4819_REG_SET(0x59, (1u << 15) | (1u << 14) | FSK_RESET_REG59), // clear FIFO's
+		BK4819_REG_SET(0x59, FSK_RESET_REG59),
+		BK4819_REG_SET(0x30, 0)
+	};
 
-	BK4819_write_reg(0x30, 0);
+	BK4819_write_regs(fsk_reset_seq, ARRAY_SIZE(fsk_reset_seq));
 }
 
 #ifdef ENABLE_AIRCOPY
@@ -1876,23 +2077,6 @@ void BK4819_reset_fsk(void)
 
 	void BK4819_start_aircopy_fsk_rx(const unsigned int packet_size)
 	{
-		uint16_t fsk_reg59;
-
-		BK4819_reset_fsk();
-
-		BK4819_write_reg(0x02, 0);    // clear interrupt flags
-
-		// set the almost full threshold
-		BK4819_write_reg(0x5E, (64u << 3) | (1u << 0));  // 0 ~ 127, 0 ~ 7
-
-		// set the packet size
-		BK4819_write_reg(0x5D, ((packet_size - 1) << 8));
-
-		BK4819_RX_TurnOn();
-
-	//	BK4819_write_reg(0x3F,                             BK4819_REG_3F_FSK_RX_FINISHED | BK4819_REG_3F_FSK_FIFO_ALMOST_FULL);
-		BK4819_write_reg(0x3F, BK4819_REG_3F_FSK_RX_SYNC | BK4819_REG_3F_FSK_RX_FINISHED | BK4819_REG_3F_FSK_FIFO_ALMOST_FULL);
-
 		// REG_59
 		//
 		// <15>  0 TX FIFO
@@ -1930,21 +2114,34 @@ void BK4819_reset_fsk(void)
 		//
 		// <2:0> 0 ???
 		//
-		fsk_reg59 = (0u << 15) |   // 0 or 1   1 = clear TX FIFO
-					(0u << 14) |   // 0 or 1   1 = clear RX FIFO
-					(0u << 13) |   // 0 or 1   1 = scramble
-					(0u << 12) |   // 0 or 1   1 = enable RX
-					(0u << 11) |   // 0 or 1   1 = enable TX
-					(0u << 10) |   // 0 or 1   1 = invert data when RX
-					(0u <<  9) |   // 0 or 1   1 = invert data when TX
-					(0u <<  8) |   // 0 or 1   ???
-	//				(6u <<  4) |   // 0 ~ 15   preamble Length Selection
-					(4u <<  4) |   // 0 ~ 15   preamble Length Selection .. 1of11 .. a little shorter than the TX length
-					(1u <<  3) |   // 0 or 1   sync length selection
-					(0u <<  0);    // 0 ~ 7    ???
-
-		BK4819_write_reg(0x59, (1u << 15) | (1u << 14) | fsk_reg59);  // clear FIFO's
-		BK4819_write_reg(0x59, (1u << 13) | (1u << 12) | fsk_reg59);  // enable scrambler, enable RX
+		// preamble length 4 .. 1of11 .. a little shorter than the TX length, 4 byte sync
+		#define AIRCOPY_RX_REG59  ((4u << 4) | (1u << 3))
+
+		static const bk4819_reg_seq_t fsk_setup_seq[] = {
+			BK4819_REG_SET(0x02, 0),                          // clear interrupt flags
+			BK4819_REG_SET(0x5E, (64u << 3) | (1u << 0))      // set the almost full threshold, 0 ~ 127, 0 ~ 7
+		};
+
+		static const bk4819_reg_seq_t fsk_rx_seq[] = {
+		//	BK4819_REG_SET(0x3F,                             BK4819_REG_3F_FSK_RX_FINISHED | BK4819_REG_3F_FSK_FIFO_ALMOST_FULL),
+			BK4819_REG_SET(0x3F, BK4819_REG_3F_FSK_RX_SYNC | BK4819_REG_3F_FSK_RX_FINISHED | BK4819_REG_3F_FSK_FIFO_ALMOST_FULL),
+
+			BK4819_REG_SET(0x59, (1u << 15) | (1u << 14) | AIRCOPY_RX_REG59),  // clear FIFO's
+			BK4819_REG_SET(0x59, (1u << 13) | (1u << 12) | AIRCOPY_RX_REG59)   // enable scrambler, enable RX
+		};
+
+		#undef AIRCOPY_RX_REG59
+
+		BK4819_reset_fsk();
+
+		BK4819_write_regs(fsk_setup_seq, ARRAY_SIZE(fsk_setup_seq));
+
+		// set the packet size
+		BK4819_write_reg(0x5D, ((packet_size - 1) << 8));
+
+		BK4819_RX_TurnOn();
+
+		BK4819_write_regs(fsk_rx_seq, ARRAY_SIZE(fsk_rx_seq));
 	}
 #endif
 
@@ -2040,30 +2237,35 @@ void BK4819_reset_fsk(void)
 		//
 		// set the packet size
 
-		if (enable)
-		{
-			const uint16_t fsk_reg59 =
-				(0u << 15) |   // 1 = clear TX FIFO
-				(0u << 14) |   // 1 = clear RX FIFO
-				(0u << 13) |   // 1 = scramble
-				(0u << 12) |   // 1 = enable RX
-				(0u << 11) |   // 1 = enable TX
-				(0u << 10) |   // 1 = invert data when RX
-				(0u <<  9) |   // 1 = invert data when TX
-				(0u <<  8) |   // ???
-				(0u <<  4) |   // 0 ~ 15 preamble length selection .. mdc1200 does not send bit reversals :(
-				(1u <<  3) |   // 0/1 sync length selection
-				(0u <<  0);    // 0 ~ 7  ???
-
-			BK4819_write_reg(0x70,
+		// packet size .. sync + 14 bytes - size of a single mdc1200 packet, round up to even, else FSK RX doesn't work
+//		#define MDC1200_RX_SIZE  (1 + (MDC1200_FEC_K * 2))
+		#define MDC1200_RX_SIZE  ((((0 + (MDC1200_FEC_K * 2)) + 1) / 2) * 2)
+
+		// 0 ~ 15 preamble length selection .. mdc1200 does not send bit reversals :(, 4 byte sync
+		#define MDC1200_RX_REG59  ((0u << 4) | (1u << 3))
+
+		static const bk4819_reg_seq_t mdc1200_rx_seq[] = {
+			// REG_5A .. bytes 1 & 2 sync pattern
+			//
+			// <15:8> sync byte 1
+			// < 7:0> sync byte 2
+			BK4819_REG_SET(0x5A, (uint16_t)(MDC1200_SYNC_SUC_XOR >> 16)),
+
+			// REG_5B .. bytes 3 & 4 sync pattern
+			//
+			// <15:8> sync byte 3
+			// < 7:0> sync byte 4
+			BK4819_REG_SET(0x5B, (uint16_t)(MDC1200_SYNC_SUC_XOR >> 0)),
+
+			BK4819_REG_SET(0x70,
 				( 0u << 15) |    // 0
 				( 0u <<  8) |    // 0
 				( 1u <<  7) |    // 1
-				(96u <<  0));    // 96
+				(96u <<  0)),    // 96
 
-			BK4819_write_reg(0x72, scale_freq(1200));
+			BK4819_REG_SET(0x72, SCALE_FREQ(1200)),
 
-			BK4819_write_reg(0x58,
+			BK4819_REG_SET(0x58,
 				(1u << 13) |		// 1 FSK TX mode selection
 									//   0 = FSK 1.2K and FSK 2.4K TX .. no tones, direct FM
 									//   1 = FFSK 1200 / 1800 TX
@@ -2106,56 +2308,42 @@ void BK4819_reset_fsk(void)
 									//   6 = ???
 									//   7 = ???
 									//
-				(1u << 0));			// 1 FSK enable
+				(1u << 0)),			// 1 FSK enable
 									//   0 = disable
 									//   1 = enable
 
-			// REG_5A .. bytes 0 & 1 sync pattern
-			//
-			// <15:8> sync byte 0
-			// < 7:0> sync byte 1
-//			BK4819_write_reg(0x5A, ((uint16_t)mdc1200_sync_suc_xor[0] << 8) | (mdc1200_sync_suc_xor[1] << 0));
-			BK4819_write_reg(0x5A, ((uint16_t)mdc1200_sync_suc_xor[1] << 8) | (mdc1200_sync_suc_xor[2] << 0));
-
-			// REG_5B .. bytes 2 & 3 sync pattern
-			//
-			// <15:8> sync byte 2
-			// < 7:0> sync byte 3
-//			BK4819_write_reg(0x5B, ((uint16_t)mdc1200_sync_suc_xor[2] << 8) | (mdc1200_sync_suc_xor[3] << 0));
-			BK4819_write_reg(0x5B, ((uint16_t)mdc1200_sync_suc_xor[3] << 8) | (mdc1200_sync_suc_xor[4] << 0));
-
 			// disable CRC
-			BK4819_write_reg(0x5C, 0x5625);   // 01010110 0 0 100101
-//			BK4819_write_reg(0x5C, 0xAA30);   // 10101010 0 0 110000
+			BK4819_REG_SET(0x5C, 0x5625),   // 01010110 0 0 100101
+//			BK4819_REG_SET(0x5C, 0xAA30),   // 10101010 0 0 110000
 
 			// set the almost full threshold
-			BK4819_write_reg(0x5E, (64u << 3) | (1u << 0));  // 0 ~ 127, 0 ~ 7
-
-			{	// packet size .. sync + 14 bytes - size of a single mdc1200 packet
-//				uint16_t size = 1 + (MDC1200_FEC_K * 2);
-				uint16_t size = 0 + (MDC1200_FEC_K * 2);
-//				size -= (fsk_reg59 & (1u << 3)) ? 4 : 2;
-				size = ((size + 1) / 2) * 2;             // round up to even, else FSK RX doesn't work
-				BK4819_write_reg(0x5D, ((size - 1) << 8));
-			}
+			BK4819_REG_SET(0x5E, (64u << 3) | (1u << 0)),  // 0 ~ 127, 0 ~ 7
+
+			BK4819_REG_SET(0x5D, (MDC1200_RX_SIZE - 1) << 8),
 
 			// clear FIFO's then enable RX
-			BK4819_write_reg(0x59, (1u << 15) | (1u << 14) | fsk_reg59);
-			BK4819_write_reg(0x59, (1u << 12) | fsk_reg59);
+			BK4819_REG_SET(0x59, (1u << 15) | (1u << 14) | MDC1200_RX_REG59),
+			BK4819_REG_SET(0x59, (1u << 12) | MDC1200_RX_REG59),
 
 			// clear interrupt flags
-			BK4819_write_reg(0x02, 0);
-
-//			BK4819_RX_TurnOn();
+			BK4819_REG_SET(0x02, 0)
 
 			// enable interrupts
-//			BK4819_write_reg(0x3F, BK4819_read_reg(0x3F) | BK4819_REG_3F_FSK_RX_SYNC | BK4819_REG_3F_FSK_RX_FINISHED | BK4819_REG_3F_FSK_FIFO_ALMOST_FULL);
-		}
+//			BK4819_REG_MODIFY(0x3F, BK4819_REG_3F_FSK_RX_SYNC | BK4819_REG_3F_FSK_RX_FINISHED | BK4819_REG_3F_FSK_FIFO_ALMOST_FULL, 0xFFFF),
+		};
+
+		static const bk4819_reg_seq_t mdc1200_off_seq[] = {
+			BK4819_REG_SET(0x70, 0),
+			BK4819_REG_SET(0x58, 0)
+		};
+
+		#undef MDC1200_RX_SIZE
+		#undef MDC1200_RX_REG59
+
+		if (enable)
+			BK4819_write_regs(mdc1200_rx_seq, ARRAY_SIZE(mdc1200_rx_seq));
 		else
-		{
-			BK4819_write_reg(0x70, 0);
-			BK4819_write_reg(0x58, 0);
-		}
+			BK4819_write_regs(mdc1200_off_seq, ARRAY_SIZE(mdc1200_off_seq));
 	}
 
 	void BK4819_send_MDC1200(const uint8_t op, const uint8_t arg, const uint16_t id, const bool long_preamble)
@@ -59,11 +59,25 @@ enum BK4819_CSS_scan_result_e
 };
 typedef enum BK4819_CSS_scan_result_e BK4819_CSS_scan_result_t;
 
-extern bool g_rx_idle_mode;
+// one step of a register sequence for BK4819_write_regs(), only the bits set
+// in mask are changed .. a full 0xFFFF mask is a plain write with no read
+typedef struct {
+	uint8_t  reg;
+	uint16_t mask;
+	uint16_t value;
+} bk4819_reg_seq_t;
+
+#define BK4819_REG_SET(reg, value)           {(reg), 0xFFFFu, (value)}
+#define BK4819_REG_MODIFY(reg, mask, value)  {(reg), (mask), (value)}
+
+extern const uint32_t rf_filter_transition_freq;
+extern bool           g_rx_idle_mode;
 
 void     BK4819_Init(void);
 uint16_t BK4819_read_reg(const uint8_t Register);
 void     BK4819_write_reg(const uint8_t Register, uint16_t Data);
+void     BK4819_write_regs(const bk4819_reg_seq_t *seq, const unsigned int count);
+void     BK4819_invalidate_reg_cache(void);
 void     BK4819_write_8(uint8_t Data);
 void     BK4819_write_16(uint16_t Data);
 
@@ -85,6 +99,7 @@ void     BK4819_SetFilterBandwidth(const BK4819_filter_bandwidth_t Bandwidth);
 
 void     BK4819_SetupPowerAmplifier(const uint8_t bias, const uint32_t frequency);
 void     BK4819_set_rf_frequency(const uint32_t frequency, const bool trigger_update);
+bool     BK4819_wait_rf_settled(const unsigned int timeout_us);
 void     BK4819_SetupSquelch(
 			uint8_t SquelchOpenRSSIThresh,
 			uint8_t SquelchCloseRSSIThresh,
@@ -164,6 +179,7 @@ uint8_t  BK4819_GetDTMF_5TONE_Code(void);
 uint8_t  BK4819_get_CDCSS_code_type(void);
 uint8_t  BK4819_GetCTCShift(void);
 uint8_t  BK4819_GetCTCType(void);
+bool     BK4819_is_squelch_open(void);
 
 void     BK4819_PlayRoger(const unsigned int type);
 
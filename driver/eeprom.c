@@ -18,12 +18,94 @@
 
 #include "driver/eeprom.h"
 #include "driver/i2c.h"
-#include "driver/system.h"
+#include "driver/systick.h"
+#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
+	#include "driver/uart.h"
+#endif
+#include "misc.h"
+#include "settings.h"
 
-void EEPROM_ReadBuffer(const uint16_t address, void *p_buffer, const unsigned int size)
+// write-back cache
+//
+// g_eeprom is a RAM mirror of the whole chip, so a write only has to update
+// the mirror and mark the 8 byte block dirty .. EEPROM_flush_10ms() then
+// trickles the dirty blocks out to the chip in the background, runs of dirty
+// blocks within a 32 byte page going out as a single page write
+//
+// a block written from outside the mirror is compared against the mirror
+// when it's queued, and only goes out if it differs. Blocks saved straight
+// out of g_eeprom (edited in place) always go out, so the code that edits in
+// place only saves the blocks it knows have changed (settings.c keeps a copy
+// of what it last saved for that) .. the chip is never read back
+
+#define EEPROM_BYTES        0x2000u
+#define EEPROM_PAGE_SIZE    32u    // 24C64 page write size
+#define EEPROM_PAGES        (EEPROM_BYTES / EEPROM_PAGE_SIZE)
+#define EEPROM_BLOCK_SIZE   8u     // dirty tracking granularity
+#define EEPROM_BLOCKS       (EEPROM_BYTES / EEPROM_BLOCK_SIZE)
+#define BLOCKS_PER_PAGE     (EEPROM_PAGE_SIZE / EEPROM_BLOCK_SIZE)
+
+// 24C64 data sheets give 5ms max for the internal write cycle, give up waiting well after that
+#define WRITE_TIMEOUT_US         20000u
+
+#define CYCLES_PER_US            (CPU_CLOCK_HZ / 1000000u)
+
+static uint32_t eeprom_dirty[EEPROM_BLOCKS / 32];    // bit set = block needs flushing
+static uint16_t eeprom_flush_page;                    // where the flusher looks next
+static bool     eeprom_busy;                          // chip is burning a block in
+static uint32_t eeprom_busy_start;                    // cycle count the write was started at
+
+#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
+	// write cycle times, only measured when we actually had to wait for the chip
+	static uint16_t eeprom_write_us_min;
+	static uint16_t eeprom_write_us_max;
+	static uint16_t eeprom_write_measured;
+	static uint16_t eeprom_write_timeouts;
+#endif
+
+static bool EEPROM_ready(const bool measure)
+{	// the chip doesn't ACK it's address till the write cycle is over
+	const uint32_t us = (SYSTICK_get_cycles() - eeprom_busy_start) / CYCLES_PER_US;
+
+	if (!eeprom_busy)
+		return true;
+
+	if (!I2C_probe(0xA0))
+	{
+		if (us < WRITE_TIMEOUT_US)
+			return false;
+
+		#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
+			eeprom_write_timeouts++;
+		#endif
+	}
+	else
+	if (measure)
+	{
+		#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
+			if (eeprom_write_measured == 0 || eeprom_write_us_min > us)
+				eeprom_write_us_min = us;
+			if (eeprom_write_us_max < us)
+				eeprom_write_us_max = us;
+			eeprom_write_measured++;
+		#endif
+	}
+
+	eeprom_busy = false;
+	return true;
+}
+
+static void EEPROM_wait_ready(void)
 {
-	if ((address + size) > 0x2000 || size == 0)
-		return;
+	if (EEPROM_ready(false))
+		return;   // finished a while ago
+
+	while (!EEPROM_ready(true)) {}
+}
+
+static void EEPROM_read_chip(const uint16_t address, void *p_buffer, const unsigned int size)
+{
+	EEPROM_wait_ready();
 
 	I2C_Start();
 	I2C_Write(0xA0);
@@ -37,44 +119,197 @@ void EEPROM_ReadBuffer(const uint16_t address, void *p_buffer, const unsigned in
 	I2C_Stop();
 }
 
-void EEPROM_WriteBuffer8(const uint16_t address, const void *p_buffer)
-{
-	if (p_buffer == NULL || (address + 8) > 0x2000)
-		return;
-
-#if 0
-	// normal way
+static void EEPROM_write_chip(const uint16_t address, const void *p_buffer, const unsigned int size)
+{	// size bytes within one page
+	EEPROM_wait_ready();
 
 	I2C_Start();
 	I2C_Write(0xA0);
 	I2C_Write((address >> 8) & 0xFF);
 	I2C_Write((address >> 0) & 0xFF);
-	I2C_WriteBuffer(p_buffer, 8);
+	I2C_WriteBuffer(p_buffer, size);
 	I2C_Stop();
 
-	// give the EEPROM time to burn the data in (apparently takes 1.5ms ~ 5ms)
-	SYSTEM_DelayMs(6);
+	// the EEPROM takes 1.5ms ~ 5ms to burn the data in, the next access polls for it to finish
+	eeprom_busy       = true;
+	eeprom_busy_start = SYSTICK_get_cycles();
+}
+
+static void EEPROM_flush_page(const unsigned int page)
+{
+	const unsigned int word    = page / (32 / BLOCKS_PER_PAGE);
+	const unsigned int shift   = (page * BLOCKS_PER_PAGE) & 31u;
+	const uint32_t     mask    = ((1u << BLOCKS_PER_PAGE) - 1) << shift;
+	const uint16_t     address = page * EEPROM_PAGE_SIZE;
+	const uint8_t     *p_data  = ((const uint8_t *)&g_eeprom) + address;
+	const unsigned int dirty   = (eeprom_dirty[word] & mask) >> shift;
+	unsigned int       i;
+
+	eeprom_dirty[word] &= ~mask;
+
+	// one page write for each run of dirty blocks, the clean ones in between are left alone
+	for (i = 0; i < BLOCKS_PER_PAGE; )
+	{
+		unsigned int first;
+
+		if ((dirty & (1u << i)) == 0)
+		{
+			i++;
+			continue;
+		}
 
-#else
-	// eeprom wear reduction
-	// only write the data if it's different to what's already there
+		for (first = i; i < BLOCKS_PER_PAGE && (dirty & (1u << i)); i++) {}
 
-	uint8_t buffer[8];
+		EEPROM_write_chip(address + (first * EEPROM_BLOCK_SIZE), p_data + (first * EEPROM_BLOCK_SIZE), (i - first) * EEPROM_BLOCK_SIZE);
+	}
+}
+
+static bool EEPROM_page_dirty(const unsigned int page)
+{
+	const unsigned int shift = (page * BLOCKS_PER_PAGE) & 31u;
+	return (eeprom_dirty[page / (32 / BLOCKS_PER_PAGE)] & (((1u << BLOCKS_PER_PAGE) - 1) << shift)) != 0;
+}
+
+static void EEPROM_flush_range(const uint16_t address, const unsigned int size)
+{	// blocking
+	unsigned int page;
+
+	for (page = address / EEPROM_PAGE_SIZE; page <= (address + size - 1) / EEPROM_PAGE_SIZE; page++)
+		if (EEPROM_page_dirty(page))
+			EEPROM_flush_page(page);
+}
+
+void EEPROM_ReadBuffer(const uint16_t address, void *p_buffer, const unsigned int size)
+{
+	if ((address + size) > EEPROM_BYTES || size == 0)
+		return;
 
-	EEPROM_ReadBuffer(address, buffer, 8);
+	// anything still waiting to go out has to be on the chip first
+	EEPROM_flush_range(address, size);
 
-	if (memcmp(p_buffer, buffer, 8) != 0)
+	EEPROM_read_chip(address, p_buffer, size);
+}
+
+static void EEPROM_queue(const uint16_t address, const uint8_t *p_data, const uint8_t fill, const unsigned int size)
+{	// p_data NULL = fill
+	//
+	// the mirror holds what's on the chip, so a block only goes out if it differs from it ..
+	// data handed over from the mirror itself has been edited in place, the caller has
+	// already decided that it's changed
+	uint8_t      *p_mirror = ((uint8_t *)&g_eeprom) + address;
+	unsigned int  i = 0;
+
+	while (i < size)
 	{
-		I2C_Start();
-		I2C_Write(0xA0);
-		I2C_Write((address >> 8) & 0xFF);
-		I2C_Write((address >> 0) & 0xFF);
-		I2C_WriteBuffer(p_buffer, 8);
-		I2C_Stop();
-
-		// give the EEPROM time to burn the data in (apparently takes 1.5ms ~ 5ms)
-		SYSTEM_DelayMs(6);
+		const unsigned int block   = (address + i) / EEPROM_BLOCK_SIZE;
+		const uint32_t     bit     = 1u << (block & 31u);
+		unsigned int       len     = EEPROM_BLOCK_SIZE - ((address + i) % EEPROM_BLOCK_SIZE);
+		bool               changed = (p_data == p_mirror);
+		unsigned int       k;
+
+		if (len > (size - i))
+			len = size - i;
+
+		if (!changed)
+		{
+			for (k = i; k < (i + len); k++)
+			{
+				const uint8_t data = (p_data != NULL) ? p_data[k] : fill;
+				if (p_mirror[k] != data)
+				{
+					p_mirror[k] = data;
+					changed     = true;
+				}
+			}
+		}
+
+		if (changed)
+			eeprom_dirty[block / 32] |= bit;
+
+		i += len;
 	}
+}
 
-#endif
+void EEPROM_WriteBuffer8(const uint16_t address, const void *p_buffer)
+{
+	if (p_buffer == NULL || (address + EEPROM_BLOCK_SIZE) > EEPROM_BYTES)
+		return;
+
+	EEPROM_queue(address, (const uint8_t *)p_buffer, 0, EEPROM_BLOCK_SIZE);
+}
+
+void EEPROM_WriteBuffer(const uint16_t address, const void *p_buffer, const unsigned int size)
+{
+	if (p_buffer == NULL || (address + size) > EEPROM_BYTES || size == 0)
+		return;
+
+	EEPROM_queue(address, (const uint8_t *)p_buffer, 0, size);
+}
+
+void EEPROM_fill(const uint16_t address, const uint8_t value, const unsigned int size)
+{
+	if ((address + size) > EEPROM_BYTES || size == 0)
+		return;
+
+	EEPROM_queue(address, NULL, value, size);
+}
+
+void EEPROM_flush_10ms(void)
+{
+	unsigned int i;
+
+	// at most one page write per tick, and never wait on the chip here
+	if (!EEPROM_ready(false))
+		return;
+
+	for (i = 0; i < EEPROM_PAGES; i++)
+	{
+		const unsigned int page = (eeprom_flush_page + i) % EEPROM_PAGES;
+
+		if ((page % (32 / BLOCKS_PER_PAGE)) == 0 && eeprom_dirty[page / (32 / BLOCKS_PER_PAGE)] == 0)
+		{	// skip the whole word
+			i += (32 / BLOCKS_PER_PAGE) - 1;
+			continue;
+		}
+
+		if (!EEPROM_page_dirty(page))
+			continue;
+
+		eeprom_flush_page = page;
+
+		EEPROM_flush_page(page);
+		return;
+	}
+}
+
+void EEPROM_flush(void)
+{	// blocking, for before a reboot
+	unsigned int page;
+
+	for (page = 0; page < EEPROM_PAGES; page++)
+		if (EEPROM_page_dirty(page))
+			EEPROM_flush_page(page);
+
+	EEPROM_wait_ready();
+
+	#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
+		if (eeprom_write_measured > 0 || eeprom_write_timeouts > 0)
+		{
+			UART_printf("eeprom write cycle %u writes %u ~ %uus, %u timeouts\r\n",
+				eeprom_write_measured, eeprom_write_us_min, eeprom_write_us_max, eeprom_write_timeouts);
+			eeprom_write_measured = 0;
+			eeprom_write_timeouts = 0;
+		}
+	#endif
+}
+
+bool EEPROM_is_dirty(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < ARRAY_SIZE(eeprom_dirty); i++)
+		if (eeprom_dirty[i] != 0)
+			return true;
+
+	return false;
 }
@@ -17,10 +17,16 @@
 #ifndef DRIVER_EEPROM_H
 #define DRIVER_EEPROM_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 void EEPROM_ReadBuffer(const uint16_t address, void *p_buffer, const unsigned int size);
-void EEPROM_WriteBuffer8(const uint16_t address, const void *p_buffer);
+void EEPROM_WriteBuffer8(const uint16_t address, const void *p_buffer);   // write-back, queues the block
+void EEPROM_WriteBuffer(const uint16_t address, const void *p_buffer, const unsigned int size);
+void EEPROM_fill(const uint16_t address, const uint8_t value, const unsigned int size);
+void EEPROM_flush_10ms(void);
+void EEPROM_flush(void);
+bool EEPROM_is_dirty(void);
 
 #endif
 
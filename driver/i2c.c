@@ -172,6 +172,17 @@ int I2C_Write(uint8_t Data)
 	return ret;
 }
 
+bool I2C_probe(const uint8_t Address)
+{	// true if the device ACK's it's address, a 24Cxx EEPROM doesn't while it's burning in a write
+	int ret;
+
+	I2C_Start();
+	ret = I2C_Write(Address);
+	I2C_Stop();
+
+	return ret == 0;
+}
+
 int I2C_ReadBuffer(void *pBuffer, const unsigned int Size, const bool fast)
 {
 	uint8_t *pData = (uint8_t *)pBuffer;
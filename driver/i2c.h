@@ -31,6 +31,7 @@ void I2C_Stop(void);
 uint8_t I2C_Read(bool bFinal);
 uint8_t I2C_Read_fast(bool bFinal);
 int I2C_Write(uint8_t Data);
+bool I2C_probe(const uint8_t Address);
 
 int I2C_ReadBuffer(void *pBuffer, unsigned int Size, const bool fast);
 int I2C_WriteBuffer(const void *pBuffer, unsigned int Size);
@@ -16,6 +16,7 @@
 
 #include <stdint.h>
 #include <stdio.h>     // NULL
+#include <string.h>
 
 #include "bsp/dp32g030/gpio.h"
 #include "bsp/dp32g030/spi.h"
@@ -28,6 +29,19 @@
 uint8_t g_status_line[128];
 uint8_t g_frame_buffer[7][128];
 
+// what the LCD is currently showing, [0] = status line
+//
+// 1kB of RAM, the price of only sending what's changed .. the screens clear the
+// whole frame buffer and redraw it every time, so comparing against this is the
+// only way to know what actually changed
+static uint8_t lcd_shadow[1 + ARRAY_SIZE(g_frame_buffer)][128];
+
+static bool    resend_all;
+
+// a gap of unchanged bytes shorter than this is cheaper to resend than to
+// send another 3 byte column/line address for
+#define MIN_SKIP_BYTES  4
+
 #ifdef ENABLE_CONTRAST
 	uint8_t contrast = 31;  // 0 ~ 63
 #endif
@@ -41,10 +55,50 @@ static inline void ST7565_LowLevelWrite(uint8_t Value)
         SPI0->WDR = Value;
 }
 
+static void ST7565_send_changes(const unsigned int lcd_line, const uint8_t *pBuffer, unsigned int column, const unsigned int last)
+{	// send only the runs of bytes that differ from what's already on the LCD
+	uint8_t *pShadow = lcd_shadow[lcd_line];
+
+	while (column <= last)
+	{
+		unsigned int end;
+		unsigned int same;
+
+		// find the start of the next change
+		while (column <= last && pBuffer[column] == pShadow[column] && !resend_all)
+			column++;
+		if (column > last)
+			break;
+
+		// find it's end, bridging over short unchanged gaps
+		for (end = column, same = 0; end <= last && same < MIN_SKIP_BYTES; end++)
+			same = (pBuffer[end] == pShadow[end] && !resend_all) ? same + 1 : 0;
+		end -= same;
+
+		ST7565_SelectColumnAndLine(column + 4U, lcd_line);
+		GPIO_SetBit(&GPIOB->DATA, GPIOB_PIN_ST7565_A0);
+		for ( ; column < end; column++)
+		{
+                    ST7565_LowLevelWrite(pBuffer[column]);
+                    pShadow[column] = pBuffer[column];
+		}
+		SPI_WaitForUndocumentedTxFifoStatusBit();
+	}
+}
+
 void ST7565_DrawLine(const unsigned int Column, const unsigned int Line, const unsigned int Size, const uint8_t *pBitmap)
 {
 	unsigned int i;
 
+	if (Line < ARRAY_SIZE(lcd_shadow) && Column < LCD_WIDTH)
+	{	// keep track of what's been put on the LCD, the next blit puts back the frame buffer contents
+		const unsigned int size = (Size <= (LCD_WIDTH - Column)) ? Size : LCD_WIDTH - Column;
+		if (pBitmap != NULL)
+			memcpy(&lcd_shadow[Line][Column], pBitmap, size);
+		else
+			memset(&lcd_shadow[Line][Column], 0, size);
+	}
+
 	SPI_ToggleMasterMode(&SPI0->CR, false);
 
 	ST7565_SelectColumnAndLine(Column + 4U, Line);
@@ -72,28 +126,15 @@ void ST7565_DrawLine(const unsigned int Column, const unsigned int Line, const u
 }
 
 void ST7565_BlitFullScreen(void)
-{
+{	// only sends the parts of the frame buffer that have changed
 	unsigned int Line;
 
-	// reset some of the displays settings to try and overcome the
-	// radios hardware problem - RF corrupting the display
-	ST7565_Init(false);
-
 	SPI_ToggleMasterMode(&SPI0->CR, false);
 
 	ST7565_WriteByte(0x40);
 
 	for (Line = 0; Line < ARRAY_SIZE(g_frame_buffer); Line++)
-	{
-		unsigned int Column;
-		ST7565_SelectColumnAndLine(4, Line + 1);
-		GPIO_SetBit(&GPIOB->DATA, GPIOB_PIN_ST7565_A0);
-		for (Column = 0; Column < ARRAY_SIZE(g_frame_buffer[0]); Column++)
-		{
-                    ST7565_LowLevelWrite(g_frame_buffer[Line][Column]);
-		}
-		SPI_WaitForUndocumentedTxFifoStatusBit();
-	}
+		ST7565_send_changes(Line + 1, g_frame_buffer[Line], 0, LCD_WIDTH - 1);
 
 	#if 0
 		// whats the delay for, it holds things up :(
@@ -108,24 +149,24 @@ void ST7565_BlitFullScreen(void)
 void ST7565_BlitStatusLine(void)
 {	// the top small text line on the display
 
-	unsigned int i;
-
 	SPI_ToggleMasterMode(&SPI0->CR, false);
 
 	ST7565_WriteByte(0x40);    // start line ?
 
-	ST7565_SelectColumnAndLine(4, 0);
+	ST7565_send_changes(0, g_status_line, 0, ARRAY_SIZE(g_status_line) - 1);
 
-	GPIO_SetBit(&GPIOB->DATA, GPIOB_PIN_ST7565_A0);
-
-	for (i = 0; i < ARRAY_SIZE(g_status_line); i++)
-	{
-                ST7565_LowLevelWrite(g_status_line[i]);
-	}
+	SPI_ToggleMasterMode(&SPI0->CR, true);
+}
 
-	SPI_WaitForUndocumentedTxFifoStatusBit();
+void ST7565_refresh(void)
+{	// reset some of the displays settings and resend everything to try and
+	// overcome the radios hardware problem - RF corrupting the display
+	ST7565_Init(false);
 
-	SPI_ToggleMasterMode(&SPI0->CR, true);
+	resend_all = true;
+	ST7565_BlitStatusLine();
+	ST7565_BlitFullScreen();
+	resend_all = false;
 }
 
 void ST7565_FillScreen(const uint8_t Value)
@@ -136,6 +177,8 @@ void ST7565_FillScreen(const uint8_t Value)
 	// radios hardware problem - RF corrupting the display
 	ST7565_Init(false);
 
+	memset(lcd_shadow, Value, sizeof(lcd_shadow));
+
 	SPI_ToggleMasterMode(&SPI0->CR, false);
 
 	for (i = 0; i < 8; i++)
@@ -29,6 +29,7 @@ extern uint8_t g_frame_buffer[7][128];
 void    ST7565_DrawLine(const unsigned int Column, const unsigned int Line, const unsigned int Size, const uint8_t *pBitmap);
 void    ST7565_BlitFullScreen(void);
 void    ST7565_BlitStatusLine(void);
+void    ST7565_refresh(void);
 void    ST7565_FillScreen(const uint8_t Value);
 void    ST7565_Init(const bool full);
 void    ST7565_HardwareReset(void);
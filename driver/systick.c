@@ -27,6 +27,22 @@ void SYSTICK_Init(void)
 	gTickMultiplier = 48;
 }
 
+// the M0 has no DWT cycle counter, so time is taken from the SysTick down
+// counter (one 10ms reload at 48MHz) combined with the SysTick interrupt count
+uint32_t SYSTICK_get_cycles(void)
+{	// free running 32-bit cycle count, wraps every ~89 seconds
+	const uint32_t reload = SysTick->LOAD + 1;
+	uint32_t       ticks;
+	uint32_t       val;
+
+	do {	// read again if the tick interrupt lands between the two reads
+		ticks = g_global_sys_tick_counter;
+		val   = SysTick->VAL;
+	} while (ticks != g_global_sys_tick_counter);
+
+	return (ticks * reload) + (reload - 1 - val);
+}
+
 void SYSTICK_Delay250ns(const uint32_t Delay)
 {
 	const uint32_t ticks = (Delay * gTickMultiplier) >> 2;
@@ -21,6 +21,7 @@
 
 void SYSTICK_Init(void);
 void SYSTICK_Delay250ns(const uint32_t Delay);
+uint32_t SYSTICK_get_cycles(void);
 
 #endif
 
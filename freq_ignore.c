@@ -1,161 +1,255 @@
 
+#include <stddef.h>     // offsetof
+#include <string.h>
+
 #if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
 	#include "driver/uart.h"
 #endif
+#include "driver/eeprom.h"
 #include "freq_ignore.h"
 #include "misc.h"
+#include "settings.h"
+
+// ranges of frequencies to ignore/skip when scanning
+//
+// kept sorted by frequency, none of them overlap or touch (touching ranges
+// are merged into one), so a lookup is a binary search on the lower edges
+//
+// the list only ever holds what fits in it's EEPROM slots, so nothing is lost
+// at power off .. an add that wouldn't fit is refused
+//
+// each slot is 4 bytes, the lower edge in 500Hz steps and how many more 500Hz
+// steps the range covers (up to 512kHz a slot, wider ranges take several), so
+// the edges of a range are widened out to the 500Hz steps when it's added
+//
+//   <31:10>  lower edge / 500Hz, 0x3FFFFF = empty slot
+//   <9:0>    span in 500Hz steps, 0 = just the one step
+//
+// the slots are spread over the free EEPROM at 0x1BD0, 0x1D00 (when the scan
+// ranges aren't using it) and 0x1D80
+#define FI_GRID          50u       // 500Hz in 10Hz units
+#define FI_SPAN_MAX      0x3FFu
+#define FI_STEP_EMPTY    0x3FFFFFu
+
+typedef struct {
+	uint32_t lower;     // 10Hz units, inclusive
+	uint32_t upper;     // 10Hz units, inclusive
+} fi_range_t;
+
+static const struct {
+	uint16_t addr;
+	uint16_t count;
+} fi_slot_block[] = {
+	{offsetof(t_eeprom, config.scan_ignore_a), ARRAY_SIZE(g_eeprom.config.scan_ignore_a)},
+	#ifndef ENABLE_SCAN_RANGES
+		{offsetof(t_eeprom, scan_ignore_b),    ARRAY_SIZE(g_eeprom.scan_ignore_b)},
+	#endif
+	{offsetof(t_eeprom, scan_ignore),          ARRAY_SIZE(g_eeprom.scan_ignore)}
+};
 
-//#define FI_CLOSE_ENOUGH_HZ   300
+#ifdef ENABLE_SCAN_RANGES
+	#define FI_SLOTS   (ARRAY_SIZE(g_eeprom.config.scan_ignore_a) + ARRAY_SIZE(g_eeprom.scan_ignore))
+#else
+	#define FI_SLOTS   (ARRAY_SIZE(g_eeprom.config.scan_ignore_a) + ARRAY_SIZE(g_eeprom.scan_ignore_b) + ARRAY_SIZE(g_eeprom.scan_ignore))
+#endif
 
-// a list of frequencies to ignore/skip when scanning
-uint32_t ignore_frequencies[64];
-int      ignore_frequencies_count = 0;
+static fi_range_t   ignore_ranges[FI_SLOTS];
+static unsigned int ignore_ranges_count = 0;
 
-void FI_clear_freq_ignored(void)
-{	// clear the ignore list
-	ignore_frequencies_count = 0;
+static bool FI_save(void)
+{	// the ranges go in the EEPROM slots lowest first, false if they don't all fit (nothing is saved then)
+	uint32_t     slots[FI_SLOTS];
+	unsigned int slot = 0;
+	unsigned int i;
 
-	#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
-		UART_SendText("ignore cleared\r\n");
-	#endif
+	memset(slots, 0xff, sizeof(slots));
+
+	for (i = 0; i < ignore_ranges_count; i++)
+	{
+		uint32_t step = ignore_ranges[i].lower / FI_GRID;
+		uint32_t last = ignore_ranges[i].upper / FI_GRID;
+
+		while (1)
+		{	// wide ranges take more than one slot
+			const uint32_t span = last - step;
+
+			if (slot >= ARRAY_SIZE(slots))
+				return false;
+
+			slots[slot++] = (step << 10) | ((span < FI_SPAN_MAX) ? span : FI_SPAN_MAX);
+
+			if (span <= FI_SPAN_MAX)
+				break;
+			step += FI_SPAN_MAX + 1;
+		}
+	}
+
+	for (i = 0, slot = 0; i < ARRAY_SIZE(fi_slot_block); slot += fi_slot_block[i++].count)
+		EEPROM_WriteBuffer(fi_slot_block[i].addr, &slots[slot], fi_slot_block[i].count * sizeof(slots[0]));   // the mirror too
+
+	return true;
 }
 
-int FI_freq_ignored(const uint32_t frequency)
-{	// return index of the ignored frequency
-
-	#ifdef FI_CLOSE_ENOUGH_HZ
-		if (frequency <= FI_CLOSE_ENOUGH_HZ || frequency >= (0xffffffff - FI_CLOSE_ENOUGH_HZ) || ignore_frequencies_count <= 0)
-			return -1;   // invalid frequency
-	#else
-		if (frequency == 0 || frequency == 0xffffffff || ignore_frequencies_count <= 0)
-			return -1;   // invalid frequency
-	#endif
+void FI_load(void)
+{	// rebuild the list from the EEPROM slots
+	unsigned int i;
 
-	if (ignore_frequencies_count >= 20)
-	{	// binary search becomes faster than sequencial as the list grows beyound a certain size
-		int low = 0;
-		int high = ignore_frequencies_count;
+	ignore_ranges_count = 0;
 
-		while (low < high)
+	for (i = 0; i < ARRAY_SIZE(fi_slot_block); i++)
+	{
+		unsigned int slot;
+
+		for (slot = 0; slot < fi_slot_block[i].count; slot++)
 		{
-			register int mid  = (low + high) / 2;
-			register uint32_t freq = ignore_frequencies[mid];
+			uint32_t value;
+			uint32_t lower;
+			uint32_t upper;
 
-			#ifdef FI_CLOSE_ENOUGH_HZ
-				if (abs((int32_t)frequency - (int32_t)freq) <= FI_CLOSE_ENOUGH_HZ)
-			#else
-				if (frequency == freq)
-			#endif
-			{	// found it
-				#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
-					UART_printf("ignored bin %u %u\r\n", frequency, mid);
-				#endif
-				return mid;
-			}
-
-			if (freq > frequency)
-				high = mid;
-			else
-				low  = mid + 1;
+			memcpy(&value, (uint8_t *)&g_eeprom + fi_slot_block[i].addr + (slot * sizeof(value)), sizeof(value));   // the mirror isn't aligned
+
+			lower = (value >> 10) * FI_GRID;
+			upper = lower + (((value & FI_SPAN_MAX) + 1) * FI_GRID) - 1;
+
+			if ((value >> 10) == FI_STEP_EMPTY || lower == 0)
+				continue;   // empty slot
+
+			FI_add_range_ignored(lower, upper, false);
 		}
 	}
-	else
-	{	// sequencial search
-		register int i;
-		for (i = 0; i < ignore_frequencies_count; i++)
-		{
-			register uint32_t freq = ignore_frequencies[i];
 
-			#ifdef FI_CLOSE_ENOUGH_HZ
-				if (abs((int32_t)frequency - (int32_t)freq) <= FI_CLOSE_ENOUGH_HZ)
-			#else
-				if (frequency == freq)
-			#endif
-			{	// found it
-				#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
-					UART_printf("ignored seq %u %u\r\n", frequency, i);
-				#endif
-				return i;
-			}
-
-			if (frequency < freq)
-				return -1;        // exit loop early as the list is sorted by frequency
+	#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
+		UART_printf("ignore loaded %u\r\n", ignore_ranges_count);
+	#endif
+}
+
+void FI_eeprom_written(const uint16_t addr, const unsigned int size)
+{	// reload the list if a write went over any of it's slots
+	unsigned int i;
+
+	for (i = 0; i < ARRAY_SIZE(fi_slot_block); i++)
+	{
+		if (addr < (fi_slot_block[i].addr + (fi_slot_block[i].count * sizeof(uint32_t))) && (addr + size) > fi_slot_block[i].addr)
+		{
+			FI_load();
+			return;
 		}
 	}
+}
 
-	return -1;    // not found
+void FI_clear_freq_ignored(void)
+{	// clear the ignore list
+	ignore_ranges_count = 0;
+	FI_save();
+
+	#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
+		UART_SendText("ignore cleared\r\n");
+	#endif
 }
 
-bool FI_add_freq_ignored(const uint32_t frequency)
-{	// add a new frequency to the ignore list
+int FI_freq_ignored(const uint32_t frequency)
+{	// return index of the range the frequency is in
+	unsigned int low  = 0;
+	unsigned int high = ignore_ranges_count;
 
-	int i;
+	if (high == 0 || frequency < ignore_ranges[0].lower || frequency > ignore_ranges[high - 1].upper)
+		return -1;   // outside all of them
+
+	// find the last range starting at or below the frequency
+	while ((high - low) > 1)
+	{
+		const unsigned int mid = (low + high) / 2;
+		if (ignore_ranges[mid].lower <= frequency)
+			low  = mid;
+		else
+			high = mid;
+	}
+
+	if (frequency > ignore_ranges[low].upper)
+		return -1;   // in the gap above it
 
 	#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
-		UART_printf("ignore add %u\r\n", frequency);
+		UART_printf("ignored %u %u\r\n", frequency, low);
 	#endif
 
-	#ifdef FI_CLOSE_ENOUGH_HZ
-		if (frequency <= FI_CLOSE_ENOUGH_HZ || frequency >= (0xffffffff - FI_CLOSE_ENOUGH_HZ))
-			return false;   // invalid frequency
-	#else
-		if (frequency == 0 || frequency == 0xffffffff)
-			return false;   // invalid frequency
+	return low;
+}
+
+bool FI_add_range_ignored(uint32_t lower, uint32_t upper, const bool save)
+{	// add a range to the ignore list, merging it with any it overlaps or touches
+	unsigned int i;
+	unsigned int k;
+
+	#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
+		UART_printf("ignore add %u %u\r\n", lower, upper);
 	#endif
 
-	if (ignore_frequencies_count >= (int)ARRAY_SIZE(ignore_frequencies))
-	{	// the list is full
-		#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
-			UART_SendText("ignore add full\r\n");
-		#endif
-		return false;  // failed
-	}
+	if (lower < FI_GRID || (upper / FI_GRID) >= FI_STEP_EMPTY || lower > upper)
+		return false;   // invalid range
+
+	// out to the 500Hz steps the EEPROM slots keep them in
+	lower -= lower % FI_GRID;
+	upper += (FI_GRID - 1) - (upper % FI_GRID);
 
-	for (i = 0; i < ignore_frequencies_count; i++)
+	// the first range that isn't entirely below the new one
+	for (i = 0; i < ignore_ranges_count && (ignore_ranges[i].upper + 1) < lower; i++) {}
+
+	// and any after it that the new one reaches
+	for (k = i; k < ignore_ranges_count && ignore_ranges[k].lower <= (upper + 1); k++)
 	{
-		register uint32_t freq = ignore_frequencies[i];
+		if (lower > ignore_ranges[k].lower)
+			lower = ignore_ranges[k].lower;
+		if (upper < ignore_ranges[k].upper)
+			upper = ignore_ranges[k].upper;
+	}
 
-		#ifdef FI_CLOSE_ENOUGH_HZ
-			if (abs((int32_t)frequency - (int32_t)freq) <= FI_CLOSE_ENOUGH_HZ)
-		#else
-			if (frequency == freq)
-		#endif
-		{	// already in the list
+	if (k == i)
+	{	// doesn't reach any, make room for it
+		if (ignore_ranges_count >= ARRAY_SIZE(ignore_ranges))
+		{	// the list is full
 			#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
-				UART_SendText("ignore add already\r\n");
+				UART_SendText("ignore add full\r\n");
 			#endif
-			return true;
+			return false;  // failed
 		}
 
-		#ifdef FI_CLOSE_ENOUGH_HZ
-			if (frequency < (freq + FI_CLOSE_ENOUGH_HZ))
-				break;        // exit loop early as the list is sorted by frequency
-		#else
-			if (frequency < freq)
-				break;        // exit loop early as the list is sorted by frequency
-		#endif
+		memmove(&ignore_ranges[i + 1], &ignore_ranges[i], sizeof(ignore_ranges[0]) * (ignore_ranges_count - i));
+		ignore_ranges_count++;
+	}
+	else
+	if ((k - i) > 1)
+	{	// swallowed more than one, close the gap
+		memmove(&ignore_ranges[i + 1], &ignore_ranges[k], sizeof(ignore_ranges[0]) * (ignore_ranges_count - k));
+		ignore_ranges_count -= (k - i) - 1;
 	}
 
-	// found the location to store the new frequency - the list is kept sorted by frequency
-
-	// make room for the new frequency
-	if (i < ignore_frequencies_count)
-		memmove(&ignore_frequencies[i + 1], &ignore_frequencies[i], sizeof(ignore_frequencies[0]) * (ignore_frequencies_count - i));
+	ignore_ranges[i].lower = lower;
+	ignore_ranges[i].upper = upper;
 
-	// add the frequency to the list
-	ignore_frequencies[i] = frequency;
-	ignore_frequencies_count++;
+	if (save && !FI_save())
+	{	// more than the EEPROM slots can keep, put the list back as it was
+		#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
+			UART_SendText("ignore add full\r\n");
+		#endif
+		FI_load();
+		return false;  // failed
+	}
 
 	#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
-		for (i = 0; i < ignore_frequencies_count; i++)
-			UART_printf("%2u %10u\r\n", i, ignore_frequencies[i]);
+		for (i = 0; i < ignore_ranges_count; i++)
+			UART_printf("%2u %10u %10u\r\n", i, ignore_ranges[i].lower, ignore_ranges[i].upper);
 	#endif
 
 	return true;
 }
 
+bool FI_add_freq_ignored(const uint32_t frequency)
+{	// add a single frequency to the ignore list
+	return FI_add_range_ignored(frequency, frequency, true);
+}
+
 void FI_sub_freq_ignored(const uint32_t frequency)
-{	// remove a frequency from the ignore list
+{	// remove the range the frequency is in from the ignore list
 
 	#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
 		UART_printf("ignore sub %u\r\n", frequency);
@@ -165,12 +259,13 @@ void FI_sub_freq_ignored(const uint32_t frequency)
 	if (index < 0)
 		return;
 
-	if (index < (ignore_frequencies_count - 1))
-		memmove(&ignore_frequencies[index], &ignore_frequencies[index + 1], sizeof(ignore_frequencies[0]) * (ignore_frequencies_count - 1));
-	ignore_frequencies_count--;
+	memmove(&ignore_ranges[index], &ignore_ranges[index + 1], sizeof(ignore_ranges[0]) * (ignore_ranges_count - index - 1));
+	ignore_ranges_count--;
+
+	FI_save();
 
 	#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
-		for (index = 0; index < ignore_frequencies_count; index++)
-			UART_printf("%2u %10u\r\n", index, ignore_frequencies[index]);
+		for (index = 0; index < (int)ignore_ranges_count; index++)
+			UART_printf("%2u %10u %10u\r\n", index, ignore_ranges[index].lower, ignore_ranges[index].upper);
 	#endif
 }
@@ -21,8 +21,11 @@
 #include <stdbool.h>
 
 #ifdef ENABLE_SCAN_IGNORE_LIST
+	void FI_load(void);
+	void FI_eeprom_written(const uint16_t addr, const unsigned int size);
 	void FI_clear_freq_ignored(void);
 	int  FI_freq_ignored(const uint32_t frequency);
+	bool FI_add_range_ignored(uint32_t lower, uint32_t upper, const bool save);
 	bool FI_add_freq_ignored(const uint32_t frequency);
 	void FI_sub_freq_ignored(const uint32_t frequency);
 #endif
@@ -77,8 +77,8 @@ const uint16_t STEP_FREQ_TABLE[21] = {
 	1, 5, 10, 25, 50, 100, 125, 1500, 3000, 5000, 10000, 12500, 25000, 50000
 };
 
-// the above step sizes will be sorted to appear to be in order to the user
-uint16_t step_freq_table_sorted[ARRAY_SIZE(STEP_FREQ_TABLE)];
+// the above step sizes appear in order to the user through 'step_freq_table_sorted',
+// which is generated at build time by utils/gen_tables.c
 
 unsigned int FREQUENCY_get_step_index(const unsigned int step_size)
 {	// return the index into 'STEP_FREQ_TABLE' for the supplied step size
@@ -90,40 +90,6 @@ unsigned int FREQUENCY_get_step_index(const unsigned int step_size)
 	return 11;
 }
 
-void FREQUENCY_init(void)
-{
-	unsigned int i;
-
-	for (i = 0; i < ARRAY_SIZE(step_freq_table_sorted); i++)
-		step_freq_table_sorted[i] = i;
-
-	// sort according to step size
-	for (i = 0; i < ARRAY_SIZE(step_freq_table_sorted) - 1; i++)
-	{
-		uint16_t step1 = STEP_FREQ_TABLE[step_freq_table_sorted[i]];
-		unsigned int k;
-		for (k = i + 1; k < ARRAY_SIZE(step_freq_table_sorted); k++)
-		{
-			const uint16_t step2 = STEP_FREQ_TABLE[step_freq_table_sorted[k]];
-			if (step2 < step1)
-			{	// swap
-				const uint16_t temp = step_freq_table_sorted[i];
-				step_freq_table_sorted[i] = step_freq_table_sorted[k];
-				step_freq_table_sorted[k] = temp;
-				step1 = STEP_FREQ_TABLE[step_freq_table_sorted[i]];
-			}
-		}
-	}
-/*
-	#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
-		UART_SendText("step ..\r\n");
-		for (i = 0; i < ARRAY_SIZE(step_freq_table_sorted); i++)
-			UART_printf("%2u %2u %5u\r\n", i, step_freq_table_sorted[i], STEP_FREQ_TABLE[step_freq_table_sorted[i]]);
-		UART_SendText("\r\n");
-	#endif
-*/
-}
-
 frequency_band_t FREQUENCY_GetBand(uint32_t Frequency)
 {
 	int band;
@@ -230,6 +196,51 @@ uint32_t FREQUENCY_floor_to_step(uint32_t freq, const uint32_t step_size, const
 //		if (step_size) *step_size = FREQ_BAND_TABLE[band].step_size;
 	}
 
+	static bool FREQUENCY_scan_range_valid(const unsigned int index)
+	{
+		const t_scan_range *range = &g_eeprom.scan_range[index];
+		return range->lower != 0xffffffff &&
+		       range->steps > 0 && range->steps != 0xffff &&
+		       range->step_setting < ARRAY_SIZE(STEP_FREQ_TABLE) &&
+		       range->mod_mode < MOD_MODE_LEN &&
+		       FREQUENCY_rx_freq_check(range->lower) == 0;
+	}
+
+	int FREQUENCY_scan_range_find(const uint32_t freq)
+	{	// the stored scan range the frequency is in, else the first one, -1 if there are none
+		int first = -1;
+		unsigned int i;
+
+		for (i = 0; i < ARRAY_SIZE(g_eeprom.scan_range); i++)
+		{
+			const t_scan_range *range = &g_eeprom.scan_range[i];
+
+			if (!FREQUENCY_scan_range_valid(i))
+				continue;
+
+			if (freq >= range->lower && freq < (range->lower + (range->steps * STEP_FREQ_TABLE[range->step_setting])))
+				return i;
+
+			if (first < 0)
+				first = i;
+		}
+
+		return first;
+	}
+
+	int FREQUENCY_scan_range_next(const int index, const int direction)
+	{	// the next stored scan range in the given direction, wraps around
+		int i = index;
+
+		do {
+			i = (i + direction + SCAN_RANGE_COUNT) % SCAN_RANGE_COUNT;
+			if (FREQUENCY_scan_range_valid(i))
+				return i;
+		} while (i != index);
+
+		return index;
+	}
+
 #endif
 
 int FREQUENCY_tx_freq_check(const uint32_t Frequency)
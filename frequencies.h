@@ -82,7 +82,7 @@ enum step_setting_e {
 typedef enum step_setting_e step_setting_t;
 
 extern const uint16_t STEP_FREQ_TABLE[21];
-extern uint16_t       step_freq_table_sorted[ARRAY_SIZE(STEP_FREQ_TABLE)];
+extern const uint8_t  step_freq_table_sorted[ARRAY_SIZE(STEP_FREQ_TABLE)];
 
 #ifdef ENABLE_NOAA
 	extern const uint32_t NOAA_FREQUENCY_TABLE[10];
@@ -91,7 +91,6 @@ extern uint16_t       step_freq_table_sorted[ARRAY_SIZE(STEP_FREQ_TABLE)];
 // ***********
 
 unsigned int     FREQUENCY_get_step_index(const unsigned int step_size);
-void             FREQUENCY_init(void);
 
 frequency_band_t FREQUENCY_GetBand(uint32_t Frequency);
 uint8_t          FREQUENCY_CalculateOutputPower(uint8_t TxpLow, uint8_t TxpMid, uint8_t TxpHigh, int32_t LowerLimit, int32_t Middle, int32_t UpperLimit, int32_t Frequency);
@@ -103,6 +102,8 @@ int              FREQUENCY_rx_freq_check(const uint32_t Frequency);
 
 #ifdef ENABLE_SCAN_RANGES
 	void FREQUENCY_scan_range(const uint32_t freq, uint32_t *lower, uint32_t *upper, uint32_t *step_size);
+	int  FREQUENCY_scan_range_find(const uint32_t freq);
+	int  FREQUENCY_scan_range_next(const int index, const int direction);
 #endif
 
 // ***********
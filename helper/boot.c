@@ -22,6 +22,7 @@
 #include "driver/keyboard.h"
 #include "driver/gpio.h"
 #include "driver/system.h"
+#include "driver/systick.h"
 #include "helper/boot.h"
 #include "misc.h"
 #include "radio.h"
@@ -29,6 +30,10 @@
 #include "ui/menu.h"
 #include "ui/ui.h"
 
+#define CYCLES_PER_US   (CPU_CLOCK_HZ / 1000000u)
+
+uint32_t g_boot_time_us[BOOT_PHASE_COUNT];
+
 boot_mode_t BOOT_GetMode(void)
 {
 	unsigned int i;
@@ -96,3 +101,12 @@ void BOOT_ProcessMode(boot_mode_t Mode)
 		GUI_SelectNextDisplay(DISPLAY_MAIN);
 	}
 }
+
+void BOOT_timestamp(const boot_phase_t phase)
+{	// only the first time through counts, some phases get re-run later on (UART EEPROM reload)
+	if (phase < BOOT_PHASE_COUNT && g_boot_time_us[phase] == 0)
+	{
+		const uint32_t us = SYSTICK_get_cycles() / CYCLES_PER_US;
+		g_boot_time_us[phase] = (us > 0) ? us : 1;
+	}
+}
@@ -30,8 +30,26 @@ enum boot_mode_e
 };
 typedef enum boot_mode_e boot_mode_t;
 
+// power-on milestones, in the order Main() normally reaches them
+enum boot_phase_e
+{
+	BOOT_PHASE_DRIVERS = 0,  // peripherals up, boot mode read
+	BOOT_PHASE_SETTINGS,     // settings (+ active channels) in the EEPROM mirror
+	BOOT_PHASE_BK4819,       // BK4819_Init()
+	BOOT_PHASE_RADIO,        // both VFO's configured and the BK4819 set up to RX
+	BOOT_PHASE_MENU,         // UI_init_menu()
+	BOOT_PHASE_SPLASH,       // boot screen, password and boot mode out of the way
+	BOOT_PHASE_MAIN_LOOP,    // entering the main loop
+	BOOT_PHASE_EEPROM,       // the entire EEPROM is in the mirror
+	BOOT_PHASE_COUNT
+};
+typedef enum boot_phase_e boot_phase_t;
+
+extern uint32_t g_boot_time_us[BOOT_PHASE_COUNT];   // since SysTick was started, 0 = not reached yet
+
 boot_mode_t BOOT_GetMode(void);
 void BOOT_ProcessMode(boot_mode_t Mode);
+void BOOT_timestamp(const boot_phase_t phase);
 
 #endif
 
@@ -14,6 +14,7 @@
  *     limitations under the License.
  */
 
+#include "ARMCM0.h"
 #ifdef ENABLE_AM_FIX
 	#include "am_fix.h"
 #endif
@@ -44,6 +45,7 @@
 	#include "mdc1200.h"
 #endif
 #include "misc.h"
+#include "profile.h"
 #include "radio.h"
 #include "settings.h"
 #include "ui/helper.h"
@@ -83,11 +85,13 @@ void MAIN_DisplayPowerOn(void)
 	memset(str1, 0, sizeof(str1));
 	memset(str2, 0, sizeof(str2));
 
-	// fetch backlight time
-	EEPROM_ReadBuffer(0x0E78, ((uint8_t *)&g_eeprom) + 0x0E78, 16);
+	#ifndef ENABLE_FAST_BOOT
+		// fetch backlight time
+		EEPROM_ReadBuffer(0x0E78, ((uint8_t *)&g_eeprom) + 0x0E78, 16);
 
-	// fetch power-on mode
-	EEPROM_ReadBuffer(0x0E90, ((uint8_t *)&g_eeprom) + 0x0E90, 16);
+		// fetch power-on mode
+		EEPROM_ReadBuffer(0x0E90, ((uint8_t *)&g_eeprom) + 0x0E90, 16);
+	#endif
 
 	switch (g_eeprom.config.setting.power_on_display_mode)
 	{
@@ -96,7 +100,9 @@ void MAIN_DisplayPowerOn(void)
 			break;
 
 		case PWR_ON_DISPLAY_MODE_VOLTAGE:
-			EEPROM_ReadBuffer(0x1F40, &g_eeprom.calib.battery, 16);
+			#ifndef ENABLE_FAST_BOOT
+				EEPROM_ReadBuffer(0x1F40, &g_eeprom.calib.battery, 16);
+			#endif
 
 			{
 				unsigned int i;
@@ -115,7 +121,9 @@ void MAIN_DisplayPowerOn(void)
 			break;
 
 		case PWR_ON_DISPLAY_MODE_MESSAGE:
-			EEPROM_ReadBuffer(0x0EB0, ((uint8_t *)&g_eeprom) + 0x0EB0, 32);
+			#ifndef ENABLE_FAST_BOOT
+				EEPROM_ReadBuffer(0x0EB0, ((uint8_t *)&g_eeprom) + 0x0EB0, 32);
+			#endif
 			memcpy(str0, g_eeprom.config.setting.welcome_line[0], 16);
 			memcpy(str1, g_eeprom.config.setting.welcome_line[1], 16);
 			memcpy(str2, Version_str, slen);
@@ -197,6 +205,16 @@ void Main(void)
 	BootMode = BOOT_GetMode();
 	g_unhide_hidden = (BootMode == BOOT_MODE_UNHIDE_HIDDEN); // flag to say include the hidden menu items
 
+	BOOT_timestamp(BOOT_PHASE_DRIVERS);
+
+	#ifdef ENABLE_FAST_BOOT
+		// only the settings and active channels, quick enough to have them before the power-on screen
+		SETTINGS_read_eeprom();
+		if (BootMode != BOOT_MODE_NORMAL)
+			SETTINGS_load_deferred_all();
+		BOOT_timestamp(BOOT_PHASE_SETTINGS);
+	#endif
+
 	if (!GPIO_CheckBit(&GPIOC->DATA, GPIOC_PIN_PTT) ||
 	     KEYBOARD_Poll() != KEY_INVALID ||
 		 BootMode != BOOT_MODE_NORMAL)
@@ -209,12 +227,15 @@ void Main(void)
 		MAIN_DisplayPowerOn();
 	}
 
-	// load the entire EEPROM contents into memory
-	SETTINGS_read_eeprom();
-
-	FREQUENCY_init();
+	#ifndef ENABLE_FAST_BOOT
+		// load the entire EEPROM contents into memory
+		SETTINGS_read_eeprom();
+		BOOT_timestamp(BOOT_PHASE_SETTINGS);
+		BOOT_timestamp(BOOT_PHASE_EEPROM);
+	#endif
 
 	BK4819_Init();
+	BOOT_timestamp(BOOT_PHASE_BK4819);
 
 	BOARD_ADC_GetBatteryInfo(&g_usb_current_voltage, &g_usb_current);
 
@@ -246,6 +267,7 @@ void Main(void)
 	RADIO_configure_channel(1, VFO_CONFIGURE_RELOAD);
 	RADIO_select_vfos();
 	RADIO_setup_registers(true);
+	BOOT_timestamp(BOOT_PHASE_RADIO);
 
 	for (i = 0; i < ARRAY_SIZE(g_battery_voltages); i++)
 		BOARD_ADC_GetBatteryInfo(&g_battery_voltages[i], &g_usb_current);
@@ -256,8 +278,8 @@ void Main(void)
 			UART_SendText("boot_unhide_hidden\r\n");
 	#endif
 
-	// sort the menu list
-	UI_SortMenu(!g_unhide_hidden);
+	UI_init_menu(!g_unhide_hidden);
+	BOOT_timestamp(BOOT_PHASE_MENU);
 
 	// wait for user to release all buttons before moving on
 	if (!GPIO_CheckBit(&GPIOC->DATA, GPIOC_PIN_PTT) ||
@@ -308,6 +330,7 @@ void Main(void)
 					if ((g_boot_tick_10ms % 25) == 0)
 						AUDIO_PlayBeep(BEEP_880HZ_40MS_OPTIONAL);
 				#endif
+				SETTINGS_load_deferred();   // may as well, we're only waiting
 			}
 		}
 
@@ -350,32 +373,40 @@ void Main(void)
 		#endif
 	}
 
+	BOOT_timestamp(BOOT_PHASE_SPLASH);
+
 	// Everything is initialised, set SLEEP* bits
 	SYSCON_REGISTER |= SYSCON_REGISTER_SLEEPONEXIT_BITS_ENABLE;
 	SYSCON_REGISTER |= SYSCON_REGISTER_SLEEPDEEP_BITS_ENABLE;
 
+	BOOT_timestamp(BOOT_PHASE_MAIN_LOOP);
+
 	while (1)
 	{
 		#if 1
 			// Mask interrupts
-			__asm volatile ("cpsid i");
+			__disable_irq();
 			if (!g_next_time_slice)
 				// Idle condition, hint the MCU to sleep
-				// CMSIS suggests GCC reorders memory and is undesirable
-				__asm volatile ("wfi":::"memory");
+				// (CMSIS's __WFI() has the memory clobber so GCC won't reorder around it)
+				__WFI();
 			// Unmask interrupts
-			__asm volatile ("cpsie i");
+			__enable_irq();
 		#endif
 
 		if (g_next_time_slice)
 		{
+			PROFILE_start(PROFILE_SLICE_10MS);
 			APP_time_slice_10ms();
+			PROFILE_stop(PROFILE_SLICE_10MS);
 			g_next_time_slice = false;
 		}
 
 		if (g_next_time_slice_500ms)
 		{
+			PROFILE_start(PROFILE_SLICE_500MS);
 			APP_time_slice_500ms();
+			PROFILE_stop(PROFILE_SLICE_500MS);
 			g_next_time_slice_500ms = false;
 		}
 	}
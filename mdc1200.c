@@ -15,7 +15,8 @@
 //    40-bit sync
 //
 const uint8_t mdc1200_pre_amble[] = {0x00, 0x00, 0x00};
-const uint8_t mdc1200_sync[5]     = {0x07, 0x09, 0x2a, 0x44, 0x6f};
+const uint8_t mdc1200_sync[5]     = {
+	(uint8_t)(MDC1200_SYNC >> 32), (uint8_t)(MDC1200_SYNC >> 24), (uint8_t)(MDC1200_SYNC >> 16), (uint8_t)(MDC1200_SYNC >> 8), (uint8_t)MDC1200_SYNC};
 //
 // before successive bit xorring:
 //    0x07092A446F
@@ -29,7 +30,8 @@ const uint8_t mdc1200_sync[5]     = {0x07, 0x09, 0x2a, 0x44, 0x6f};
 //    1111 1011 0111 0010 0100 0000 1001 1001 1010 0111   .. bit inverted
 //    0xFB724099A7
 //
-uint8_t mdc1200_sync_suc_xor[sizeof(mdc1200_sync)];
+const uint8_t mdc1200_sync_suc_xor[sizeof(mdc1200_sync)] = {
+	(uint8_t)(MDC1200_SYNC_SUC_XOR >> 32), (uint8_t)(MDC1200_SYNC_SUC_XOR >> 24), (uint8_t)(MDC1200_SYNC_SUC_XOR >> 16), (uint8_t)(MDC1200_SYNC_SUC_XOR >> 8), (uint8_t)MDC1200_SYNC_SUC_XOR};
 
 /*
 uint8_t bit_reverse_8(uint8_t n)
@@ -772,8 +774,5 @@ void test(void)
 
 void MDC1200_init(void)
 {
-	memcpy(mdc1200_sync_suc_xor, mdc1200_sync, sizeof(mdc1200_sync));
-	xor_modulation(mdc1200_sync_suc_xor, sizeof(mdc1200_sync_suc_xor));
-
 	MDC1200_reset_rx();
 }
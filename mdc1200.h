@@ -89,8 +89,12 @@ enum mdc1200_op_code_e {
 };
 typedef enum mdc1200_op_code_e mdc1200_op_code_t;
 
+// 40-bit sync pattern, before and after xor_modulation() (successive bit xor, then inverted)
+#define MDC1200_SYNC          0x07092A446Full
+#define MDC1200_SYNC_SUC_XOR  (~(MDC1200_SYNC ^ (MDC1200_SYNC >> 1)) & 0xFFFFFFFFFFull)
+
 extern const uint8_t mdc1200_sync[5];
-extern uint8_t mdc1200_sync_suc_xor[sizeof(mdc1200_sync)];
+extern const uint8_t mdc1200_sync_suc_xor[sizeof(mdc1200_sync)];
 
 extern uint8_t  mdc1200_op;
 extern uint8_t  mdc1200_arg;
@@ -41,6 +41,8 @@ const uint8_t         dtmf_txstop_500ms                =   3000 / 500;  // 6 sec
 const uint8_t         serial_config_tick_500ms         =   3000 / 500;  // 3 seconds
 
 const uint8_t         key_input_timeout_500ms          =   6000 / 500;  // 6 seconds
+
+const uint8_t         lcd_refresh_500ms                =   2000 / 500;  // 2 seconds .. LCD re-init + full redraw
 #ifdef ENABLE_KEYLOCK
 	const uint8_t     key_lock_timeout_500ms           =  30000 / 500;  // 30 seconds
 #endif
@@ -195,6 +197,15 @@ uint32_t              g_scan_restore_frequency;
 bool                  g_scan_pause_time_mode;      // set if we stopped in SCAN_RESUME_TIME mode
 volatile uint16_t     g_scan_tick_10ms;
 scan_state_dir_t      g_scan_state_dir;
+#ifdef ENABLE_FASTER_CHANNEL_SCAN
+	uint16_t          g_scan_hops_per_sec;
+#endif
+#ifdef ENABLE_SCAN_RANGES
+	int8_t            g_scan_range_index = -1;
+	uint8_t           g_scan_restore_mod_mode;
+	uint8_t           g_scan_restore_bandwidth;
+	uint8_t           g_scan_restore_step_setting;
+#endif
 
 uint8_t               g_rx_vfo_num;
 bool                  g_rx_vfo_is_active;
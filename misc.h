@@ -137,6 +137,8 @@ extern const uint8_t         serial_config_tick_500ms;
 
 extern const uint8_t         key_input_timeout_500ms;
 
+extern const uint8_t         lcd_refresh_500ms;
+
 #ifdef ENABLE_KEYLOCK
 	extern const uint8_t     key_lock_timeout_500ms;
 #endif
@@ -283,6 +285,15 @@ extern uint32_t              g_scan_restore_frequency; // the frequency we were
 extern bool                  g_scan_pause_time_mode;   // set if we stopped in SCAN_RESUME_TIME mode
 extern volatile uint16_t     g_scan_tick_10ms;         // ticks till we move to next channel/frequency
 extern scan_state_dir_t      g_scan_state_dir;         // the direction we're scanning in
+#ifdef ENABLE_FASTER_CHANNEL_SCAN
+	extern uint16_t          g_scan_hops_per_sec;      // measured scan rate
+#endif
+#ifdef ENABLE_SCAN_RANGES
+	extern int8_t            g_scan_range_index;       // the stored scan range being scanned, -1 = not scanning them
+	extern uint8_t           g_scan_restore_mod_mode;  // the VFO settings the scan ranges changed, restored
+	extern uint8_t           g_scan_restore_bandwidth; // along with the frequency
+	extern uint8_t           g_scan_restore_step_setting;
+#endif
 
 extern uint8_t               g_rx_vfo_num;
 extern bool                  g_rx_vfo_is_active;
@@ -307,6 +318,7 @@ extern volatile uint8_t      g_found_ctcss_tick_10ms;
 	extern volatile uint16_t g_vox_stop_tick_10ms;
 #endif
 extern volatile bool         g_next_time_slice_40ms;
+extern volatile uint32_t     g_global_sys_tick_counter;   // 10ms SysTick interrupts since power on
 #ifdef ENABLE_NOAA
 	extern volatile uint16_t g_noaa_tick_10ms;
 	extern volatile bool     g_schedule_noaa;
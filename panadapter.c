@@ -1,4 +1,6 @@
 
+#include <string.h>
+
 #ifdef ENABLE_AM_FIX
 	#include "am_fix.h"
 #endif
@@ -11,6 +13,7 @@
 	#include "app/fm.h"
 #endif
 #include "driver/bk4819.h"
+#include "driver/systick.h"
 #include "functions.h"
 #include "misc.h"
 #include "radio.h"
@@ -19,37 +22,59 @@
 #include "ui/main.h"
 #include "ui/ui.h"
 
+#define CYCLES_PER_US   (CPU_CLOCK_HZ / 1000000u)
+
 bool         g_panadapter_enabled;
 #ifdef ENABLE_PANADAPTER_PEAK_FREQ
 	uint32_t g_panadapter_peak_freq;
 #endif
 int          g_panadapter_vfo_mode;     // > 0 if we're currently sampling the VFO
-uint8_t      g_panadapter_rssi[PANADAPTER_BINS + 1 + PANADAPTER_BINS];
-uint8_t      g_panadapter_max_rssi;
-uint8_t      g_panadapter_min_rssi;
+uint8_t      g_panadapter_rssi[PANADAPTER_BINS + 1 + PANADAPTER_BINS];   // exponential average of each bin
+uint8_t      g_panadapter_peak[PANADAPTER_BINS + 1 + PANADAPTER_BINS];   // decaying peak hold of each bin
+uint8_t      g_panadapter_max_rssi;     // highest peak hold over the last sweep
+uint8_t      g_panadapter_min_rssi;     // noise floor
 unsigned int panadapter_rssi_index;
 
+// running statistics, all updated a bin at a time as the sweep goes along
+static uint16_t panadapter_avg_x16[PANADAPTER_BINS + 1 + PANADAPTER_BINS];   // 0 = not measured yet
+static uint16_t panadapter_floor_x16;    // lower percentile of every bin read, 0 = not measured yet
+static uint8_t  sweep_max_rssi;
+#ifdef ENABLE_PANADAPTER_PEAK_FREQ
+	static uint8_t  sweep_peak_rssi;
+	static uint32_t sweep_peak_freq;
+#endif
+
 bool PAN_scanning(void)
 {
 	return (g_eeprom.config.setting.panadapter && g_panadapter_enabled && g_panadapter_vfo_mode <= 0) ? true : false;
 }
 
-void PAN_set_freq(void)
-{	// set the frequency
-
-	int32_t freq = g_tx_vfo->p_rx->frequency;
+static bool freq_settled;   // the synthesizer settled on the last frequency we set
+static bool vfo_held;       // the sweep is holding off for the VFO squelch
 
+static uint32_t PAN_bin_freq(const unsigned int index)
+{
 	int32_t step_size = g_tx_vfo->step_freq;
 	step_size = (step_size < PANADAPTER_MIN_STEP) ? PANADAPTER_MIN_STEP : (step_size > PANADAPTER_MAX_STEP) ? PANADAPTER_MAX_STEP : step_size;
 
+	return g_tx_vfo->p_rx->frequency + (step_size * ((int)index - PANADAPTER_BINS));
+}
+
+void PAN_set_freq(void)
+{	// set the frequency
+
+	uint32_t freq = g_tx_vfo->p_rx->frequency;
+
 	if (g_panadapter_enabled && g_panadapter_vfo_mode <= 0)
 	{	// panadapter mode .. add the bin offset
-		freq += step_size * ((int)panadapter_rssi_index - PANADAPTER_BINS);
+		freq = PAN_bin_freq(panadapter_rssi_index);
 	}
 
 	BK4819_set_rf_frequency(freq, true);  // set the VCO/PLL
 	//BK4819_set_rf_filter_path(freq);    // set the proper LNA/PA filter path
 
+	freq_settled = BK4819_wait_rf_settled(PANADAPTER_SETTLE_TIMEOUT_US);
+
 	// default front end gains
 	#ifdef ENABLE_AM_FIX
 		if (g_panadapter_vfo_mode <= 0 || g_tx_vfo->channel.mod_mode == MOD_MODE_FM)
@@ -59,6 +84,152 @@ void PAN_set_freq(void)
 	#endif
 }
 
+static void PAN_reset_stats(void)
+{
+	memset(g_panadapter_rssi,  0, sizeof(g_panadapter_rssi));
+	memset(g_panadapter_peak,  0, sizeof(g_panadapter_peak));
+	memset(panadapter_avg_x16, 0, sizeof(panadapter_avg_x16));
+	panadapter_floor_x16  = 0;
+	sweep_max_rssi        = 0;
+	g_panadapter_max_rssi = 0;
+	g_panadapter_min_rssi = 0;
+	#ifdef ENABLE_PANADAPTER_PEAK_FREQ
+		sweep_peak_rssi        = 0;
+		sweep_peak_freq        = 0;
+		g_panadapter_peak_freq = 0;
+	#endif
+}
+
+static void PAN_update_bin(const unsigned int index, const uint8_t rssi, const bool track_floor)
+{	// fold a new reading into the bin's average and peak hold, and into the noise floor
+	const unsigned int rssi_x16 = (unsigned int)rssi * 16;
+	uint16_t           avg_x16  = panadapter_avg_x16[index];
+	unsigned int       peak     = g_panadapter_peak[index];
+
+	if (avg_x16 == 0)
+		avg_x16 = (rssi_x16 > 0) ? rssi_x16 : 1;
+	else
+		avg_x16 = (int)avg_x16 + (((int)rssi_x16 - (int)avg_x16) / PANADAPTER_AVG_WEIGHT);
+	panadapter_avg_x16[index] = avg_x16;
+	g_panadapter_rssi[index]  = avg_x16 / 16;
+
+	// the peak hold drops back a little each time it's revisited
+	peak = (peak > PANADAPTER_PEAK_DECAY) ? peak - PANADAPTER_PEAK_DECAY : 0;
+	if (peak < rssi)
+		peak = rssi;
+	g_panadapter_peak[index] = peak;
+
+	if (track_floor)
+	{	// noise floor .. stepping down 9 times harder than up settles it where 10% of the readings are below it
+		if (panadapter_floor_x16 == 0)
+			panadapter_floor_x16 = (rssi_x16 > 0) ? rssi_x16 : 1;
+		else
+		if (rssi_x16 < panadapter_floor_x16)
+			panadapter_floor_x16 -= (panadapter_floor_x16 > (PANADAPTER_FLOOR_STEP * 9)) ? PANADAPTER_FLOOR_STEP * 9 : panadapter_floor_x16 - 1;
+		else
+		if (panadapter_floor_x16 < (255 * 16))
+			panadapter_floor_x16 += PANADAPTER_FLOOR_STEP;
+	}
+
+	if (sweep_max_rssi < peak)
+		sweep_max_rssi = peak;
+
+	#ifdef ENABLE_PANADAPTER_PEAK_FREQ
+	{	// strongest average well clear of the noise floor, the VFO's own bins aside
+		const unsigned int floor = panadapter_floor_x16 / 16;
+		unsigned int       span  = (g_panadapter_max_rssi > floor) ? g_panadapter_max_rssi - floor : 0;
+		if (span < 80)
+			span = 80;
+
+		if (g_panadapter_rssi[index] > sweep_peak_rssi &&
+		    g_panadapter_rssi[index] >= (floor + (span / 4)) &&
+		   (index < (PANADAPTER_BINS - 1) || index > (PANADAPTER_BINS + 1)))
+		{
+			sweep_peak_rssi = g_panadapter_rssi[index];
+			sweep_peak_freq = PAN_bin_freq(index);
+		}
+	}
+	#endif
+}
+
+static void PAN_sweep_done(void)
+{	// the last bin value .. publish the sweep's scale/peak and draw the panadapter once each scan cycle
+	const unsigned int floor = panadapter_floor_x16 / 16;
+
+	g_panadapter_max_rssi = sweep_max_rssi;
+	g_panadapter_min_rssi = (floor < sweep_max_rssi) ? floor : sweep_max_rssi;
+	sweep_max_rssi        = 0;
+
+	#ifdef ENABLE_PANADAPTER_PEAK_FREQ
+		g_panadapter_peak_freq = sweep_peak_freq;
+		sweep_peak_rssi        = 0;
+		sweep_peak_freq        = 0;
+	#endif
+
+	UI_DisplayMain_pan(true);
+	//g_update_display = true;
+}
+
+static void PAN_burst(void)
+{	// as many bins as fit in this slice's time budget, each read as soon as the synthesizer
+	// has settled on it, then back to the VFO frequency if it's due a visit
+	const unsigned int quarter    = (ARRAY_SIZE(g_panadapter_rssi) + 3) / 4;
+	const uint32_t     start      = SYSTICK_get_cycles();
+	bool               sweep_done = false;
+
+	g_panadapter_vfo_mode = 0;
+
+	while (1)
+	{
+		PAN_set_freq();
+
+		// save the RSSI value .. unless the synthesizer never settled on the bin, keep the last value then
+		if (freq_settled)
+		{
+			const uint16_t rssi = BK4819_GetRSSI();
+			PAN_update_bin(panadapter_rssi_index, (rssi <= 255) ? rssi : 255, true);
+		}
+
+		// next frequency
+		if (++panadapter_rssi_index >= ARRAY_SIZE(g_panadapter_rssi))
+		{
+			panadapter_rssi_index = 0;
+			sweep_done            = true;
+			break;
+		}
+
+		if (g_eeprom.config.setting.panadapter_revisit == PAN_REVISIT_QUARTER && (panadapter_rssi_index % quarter) == 0)
+			break;
+
+		// stop while there's still time to settle on one more bin
+		if ((SYSTICK_get_cycles() - start) >= ((PANADAPTER_BURST_BUDGET_US - PANADAPTER_SETTLE_TIMEOUT_US) * CYCLES_PER_US))
+			break;
+	}
+
+	switch (g_eeprom.config.setting.panadapter_revisit)
+	{
+		default:
+		case PAN_REVISIT_BURST:
+			g_panadapter_vfo_mode = 1;    // the rest of this slice
+			break;
+		case PAN_REVISIT_QUARTER:
+			g_panadapter_vfo_mode = ((panadapter_rssi_index % quarter) == 0) ? 5 : 0;    // 50ms
+			break;
+		case PAN_REVISIT_SWEEP:
+			g_panadapter_vfo_mode = sweep_done ? 10 : 0;    // 100ms
+			break;
+	}
+
+	if (g_panadapter_vfo_mode > 0)
+	{	// back to the VFO frequency
+		PAN_set_freq();
+		BK4819_write_reg(0x02, 0);   // throw away anything the bins caused
+	}
+
+	if (sweep_done)
+		PAN_sweep_done();
+}
+
 void PAN_process_10ms(void)
 {
 	if (!g_eeprom.config.setting.panadapter         ||
@@ -99,14 +270,9 @@ void PAN_process_10ms(void)
 	if (!g_panadapter_enabled)
 	{	// enable the panadapter
 
-		#ifdef ENABLE_PANADAPTER_PEAK_FREQ
-			g_panadapter_peak_freq = 0;
-		#endif
+		PAN_reset_stats();
 		g_panadapter_vfo_mode = 0;
-//		g_panadapter_max_rssi = 0;
-//		g_panadapter_min_rssi = 0;
 		panadapter_rssi_index = 0;
-//		memset(g_panadapter_rssi, 0, sizeof(g_panadapter_rssi));
 		g_panadapter_enabled  = true;
 		PAN_set_freq();
 
@@ -119,87 +285,26 @@ void PAN_process_10ms(void)
 
 		// save the current RSSI value .. center bin is the VFO frequency
 		const int16_t rssi = g_current_rssi[g_eeprom.config.setting.tx_vfo_num];
-		g_panadapter_rssi[PANADAPTER_BINS] = (rssi > 255) ? 255 : (rssi < 0) ? 0 : rssi;
+		PAN_update_bin(PANADAPTER_BINS, (rssi > 255) ? 255 : (rssi < 0) ? 0 : rssi, false);   // not a noise floor reading
 
 		g_panadapter_vfo_mode = 40;   // pause scanning for at least another 400ms
 		return;
 	}
 
-	if (g_panadapter_vfo_mode <= 0)
-	{	// scanning
-
-		// save the current RSSI value
-		const uint16_t rssi = BK4819_GetRSSI();
-		g_panadapter_rssi[panadapter_rssi_index] = (rssi <= 255) ? rssi : 255;
-
-		// next frequency
-		if (++panadapter_rssi_index >= ARRAY_SIZE(g_panadapter_rssi))
-			panadapter_rssi_index = 0;
-
-		if (g_tx_vfo->channel.mod_mode == MOD_MODE_FM)
-		{	// switch back to the VFO frequency for 100ms once every 400ms
-			g_panadapter_vfo_mode = ((panadapter_rssi_index % 40) == 0) ? 10 : 0;
-		}
-		else
-		{	// switch back to the VFO frequency for 100ms once each scan cycle
-			g_panadapter_vfo_mode = (panadapter_rssi_index == 0) ? 10 : 0;
-		}
-	}
-	else
+	if (g_panadapter_vfo_mode > 0)
 	{	// checking the VFO frequency for a signal
-		g_panadapter_vfo_mode--;
-	}
-
-	PAN_set_freq();
-
-	// the last bin value .. draw the panadapter once each scan cycle
-	if (panadapter_rssi_index == 0)
-	{
-		int i;
-
-		// compute the min/max RSSI values
-		g_panadapter_max_rssi = g_panadapter_rssi[0];
-		g_panadapter_min_rssi = g_panadapter_rssi[0];
-		for (i = 1; i < (int)ARRAY_SIZE(g_panadapter_rssi); i++)
-		{
-			const uint8_t rssi = g_panadapter_rssi[i];
-			if (g_panadapter_max_rssi < rssi)
-				g_panadapter_max_rssi = rssi;
-			if (g_panadapter_min_rssi > rssi)
-				g_panadapter_min_rssi = rssi;
-		}
-
-		#ifdef ENABLE_PANADAPTER_PEAK_FREQ
-		{	// find the peak freq
-
-			const int32_t center_freq = g_tx_vfo->p_rx->frequency;
-			int32_t step_size = g_tx_vfo->step_freq;
-
-			uint8_t peak_rssi = 0;
-			uint8_t threshold_rssi;
-			uint8_t span_rssi = g_panadapter_max_rssi - g_panadapter_min_rssi;
-			if (span_rssi < 80)
-				span_rssi = 80;
-			threshold_rssi = g_panadapter_min_rssi + (span_rssi / 4);
-
-			// limit the step size
-			step_size = (step_size < PANADAPTER_MIN_STEP) ? PANADAPTER_MIN_STEP : (step_size > PANADAPTER_MAX_STEP) ? PANADAPTER_MAX_STEP : step_size;
-
-			g_panadapter_peak_freq = 0;
-
-			for (i = 0; i < (int)ARRAY_SIZE(g_panadapter_rssi); i++)
-			{
-				const uint8_t rssi = g_panadapter_rssi[i];
-				if (peak_rssi < rssi && rssi >= threshold_rssi && (i < (PANADAPTER_BINS - 1) || i > (PANADAPTER_BINS + 1)))
-				{
-					peak_rssi = rssi;
-					g_panadapter_peak_freq = center_freq + (step_size * (i - PANADAPTER_BINS));
-				}
-			}
+		if (--g_panadapter_vfo_mode > 0)
+			return;
+
+		if (!vfo_held && BK4819_GetRSSI() >= g_tx_vfo->squelch_open_rssi_thresh)
+		{	// something there the squelch might open on .. a revisit is too short for it
+			// to make it's mind up, so stay on the VFO frequency until it has
+			vfo_held              = true;
+			g_panadapter_vfo_mode = PANADAPTER_SQUELCH_SETTLE_10MS;
+			return;
 		}
-		#endif
-
-		UI_DisplayMain_pan(true);
-		//g_update_display = true;
 	}
+
+	vfo_held = false;
+	PAN_burst();
 }
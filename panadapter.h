@@ -28,10 +28,32 @@
 #define PANADAPTER_MAX_STEP    2500
 #define PANADAPTER_MIN_STEP    625
 
+// longest we wait for the synthesizer to settle after each retune
+#define PANADAPTER_SETTLE_TIMEOUT_US   1000
+
+// time each 10ms slice may spend sweeping a burst of bins
+#define PANADAPTER_BURST_BUDGET_US     4000
+
+// how long the sweep holds off once the VFO frequency has enough RSSI for the squelch
+// to open, the same as the scan gives the squelch to make it's mind up
+#define PANADAPTER_SQUELCH_SETTLE_10MS 6
+
+#define PANADAPTER_AVG_WEIGHT   4     // each new reading moves a bin's average this fraction of the way
+#define PANADAPTER_PEAK_DECAY   1     // RSSI units (0.5dB) the peak hold drops back each sweep
+#define PANADAPTER_FLOOR_STEP   2     // 1/16th RSSI units the noise floor rises with each reading above it
+
+enum pan_revisit_e {
+	PAN_REVISIT_BURST = 0,   // back to the VFO for the rest of the slice after every burst
+	PAN_REVISIT_QUARTER,     // back to the VFO for 50ms every quarter sweep
+	PAN_REVISIT_SWEEP        // back to the VFO for 100ms once each sweep
+};
+typedef enum pan_revisit_e pan_revisit_t;
+
 extern bool     g_panadapter_enabled;
 extern uint32_t g_panadapter_peak_freq;
 extern int      g_panadapter_vfo_mode;
 extern uint8_t  g_panadapter_rssi[PANADAPTER_BINS + 1 + PANADAPTER_BINS];
+extern uint8_t  g_panadapter_peak[PANADAPTER_BINS + 1 + PANADAPTER_BINS];
 extern uint8_t  g_panadapter_max_rssi;
 extern uint8_t  g_panadapter_min_rssi;
 
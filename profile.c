@@ -0,0 +1,91 @@
+/* Copyright 2023 One of Eleven
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include <string.h>
+
+#include "driver/systick.h"
+#include "misc.h"
+#include "profile.h"
+
+profile_stats_t g_profile[PROFILE_SECTION_COUNT];
+uint32_t        g_profile_overruns;
+uint32_t        g_profile_missed_ticks;
+
+static uint32_t slice_start_tick;
+
+void PROFILE_reset(void)
+{	// leaves any section currently being timed running
+	unsigned int i;
+
+	for (i = 0; i < PROFILE_SECTION_COUNT; i++)
+	{
+		profile_stats_t *p = &g_profile[i];
+		p->count        = 0;
+		p->min_cycles   = 0xffffffff;
+		p->max_cycles   = 0;
+		p->total_cycles = 0;
+		memset(p->hist, 0, sizeof(p->hist));
+	}
+
+	g_profile_overruns     = 0;
+	g_profile_missed_ticks = 0;
+}
+
+void PROFILE_start(const profile_section_t section)
+{
+	profile_stats_t *p = &g_profile[section];
+
+	if (p->depth++ > 0)
+		return;
+
+	p->start = SYSTICK_get_cycles();
+
+	if (section == PROFILE_SLICE_10MS)
+		slice_start_tick = g_global_sys_tick_counter;
+}
+
+void PROFILE_stop(const profile_section_t section)
+{
+	profile_stats_t *p = &g_profile[section];
+	uint32_t         cycles;
+	unsigned int     bucket;
+
+	if (p->depth == 0 || --p->depth > 0)
+		return;
+
+	cycles = SYSTICK_get_cycles() - p->start;
+
+	if (p->count == 0 || p->min_cycles > cycles)
+		p->min_cycles = cycles;
+	if (p->max_cycles < cycles)
+		p->max_cycles = cycles;
+	p->total_cycles += cycles;
+	p->count++;
+
+	for (bucket = 0; bucket < (PROFILE_HIST_BUCKETS - 1) && cycles >= (1024u << bucket); bucket++) {}
+	if (p->hist[bucket] < 0xffff)
+		p->hist[bucket]++;
+
+	if (section == PROFILE_SLICE_10MS)
+	{	// the tick(s) that came in while we were busy are thrown away when main() clears g_next_time_slice
+		const uint32_t ticks = g_global_sys_tick_counter - slice_start_tick;
+		if (ticks > 0)
+		{
+			g_profile_overruns++;
+			g_profile_missed_ticks += ticks;
+		}
+	}
+}
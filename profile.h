@@ -0,0 +1,59 @@
+/* Copyright 2023 One of Eleven
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+
+enum profile_section_e {
+	PROFILE_SLICE_10MS = 0,     // APP_time_slice_10ms()
+	PROFILE_SLICE_500MS,        // APP_time_slice_500ms()
+	PROFILE_DISPLAY,            // GUI_DisplayScreen()
+	PROFILE_RADIO_IRQ,          // APP_process_radio_interrupts()
+	PROFILE_SETTINGS_SAVE,      // SETTINGS_save*()
+	PROFILE_SECTION_COUNT
+};
+typedef enum profile_section_e profile_section_t;
+
+// log2 cycle histogram, bucket 0 is < 1024 cycles (~21us), bucket n is
+// [2^(9+n), 2^(10+n)) cycles, the last bucket takes anything longer
+#define PROFILE_HIST_BUCKETS   12
+
+typedef struct {
+	uint32_t count;
+	uint32_t min_cycles;
+	uint32_t max_cycles;
+	uint64_t total_cycles;
+	uint16_t hist[PROFILE_HIST_BUCKETS];   // saturating
+	uint8_t  depth;                        // nesting, only the outer call is timed
+	uint32_t start;
+} profile_stats_t;
+
+#ifdef ENABLE_PROFILER
+	extern profile_stats_t g_profile[PROFILE_SECTION_COUNT];
+	extern uint32_t        g_profile_overruns;       // 10ms slices that ran into the next tick
+	extern uint32_t        g_profile_missed_ticks;   // 10ms ticks lost to those overruns
+
+	void     PROFILE_reset(void);
+	void     PROFILE_start(const profile_section_t section);
+	void     PROFILE_stop(const profile_section_t section);
+#else
+	#define PROFILE_start(section)
+	#define PROFILE_stop(section)
+#endif
+
+#endif
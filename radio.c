@@ -57,68 +57,106 @@ dcs_code_type_t g_current_code_type;
 uint8_t         g_selected_code;
 vfo_state_t     g_vfo_state[2];
 
-bool RADIO_channel_valid(uint16_t Channel, bool bCheckScanList, uint8_t VFO)
-{	// return true if the channel appears valid
-
-	unsigned int   i;
-	uint8_t        priority_channel[2];
+// the user channels RADIO_channel_valid() passes, one bitmap per scan list check ..
+// [0] no scan list check, [1]/[2] VFO A/B scan list minus that list's priority channels
+//
+// kept up to date from the channel attributes by RADIO_update_scan_index(), so
+// finding the next channel only has to look for a set bit, 8 channels at a time
+static uint8_t scan_index[3][(USER_CHANNEL_LAST + 1) / 8];
+
+void RADIO_update_scan_index(const unsigned int channel)
+{
+	t_channel_attrib attributes;
+	unsigned int     list;
+	uint8_t          bit;
 
-	if (Channel > USER_CHANNEL_LAST)
-		return false;
+	if (channel > USER_CHANNEL_LAST)
+		return;
 
-	if (g_eeprom.config.channel_attributes[Channel].band > BAND7_470MHz)
-		return false;
+	attributes = g_eeprom.config.channel_attributes[channel];
+	bit        = 1u << (channel & 7u);
 
-	if (bCheckScanList)
+	for (list = 0; list < ARRAY_SIZE(scan_index); list++)
 	{
-		switch (VFO)
-		{
-			case 0:
-				if (g_eeprom.config.channel_attributes[Channel].scanlist1 == 0)
-					return false;
+		bool valid = (attributes.band <= BAND7_470MHz);
 
-				for (i = 0; i < 2; i++)
-					priority_channel[i] = g_eeprom.config.setting.priority_scan_list[VFO].channel[i];
-				break;
+		if (list > 0)
+		{
+			const unsigned int vfo = list - 1;
+			if ((vfo == 0 && attributes.scanlist1 == 0) ||
+			    (vfo == 1 && attributes.scanlist2 == 0) ||
+			     g_eeprom.config.setting.priority_scan_list[vfo].channel[0] == channel ||
+			     g_eeprom.config.setting.priority_scan_list[vfo].channel[1] == channel)
+			{
+				valid = false;
+			}
+		}
 
-			case 1:
-				if (g_eeprom.config.channel_attributes[Channel].scanlist2 == 0)
-					return false;
+		if (valid)
+			scan_index[list][channel / 8] |= bit;
+		else
+			scan_index[list][channel / 8] &= ~bit;
+	}
+}
 
-				for (i = 0; i < 2; i++)
-					priority_channel[i] = g_eeprom.config.setting.priority_scan_list[VFO].channel[i];
-				break;
+void RADIO_build_scan_index(void)
+{
+	unsigned int channel;
+	for (channel = 0; channel <= USER_CHANNEL_LAST; channel++)
+		RADIO_update_scan_index(channel);
+}
 
-			default:
-				return true;
-		}
+static const uint8_t * RADIO_scan_index_list(const bool bCheckScanList, const uint8_t VFO)
+{
+	return scan_index[(bCheckScanList && VFO < 2) ? 1 + VFO : 0];
+}
 
-		if (priority_channel[0] == Channel)
-			return false;
+bool RADIO_channel_valid(uint16_t Channel, bool bCheckScanList, uint8_t VFO)
+{	// return true if the channel appears valid
 
-		if (priority_channel[1] == Channel)
-			return false;
-	}
+	if (Channel > USER_CHANNEL_LAST)
+		return false;
 
-	return true;
+	return (RADIO_scan_index_list(bCheckScanList, VFO)[Channel / 8] & (1u << (Channel & 7u))) ? true : false;
 }
 
 uint8_t RADIO_FindNextChannel(uint8_t Channel, scan_state_dir_t Direction, bool bCheckScanList, uint8_t VFO)
 {
-	unsigned int i;
+	const uint8_t *list = RADIO_scan_index_list(bCheckScanList, VFO);
+	unsigned int   chan;
+	unsigned int   i;
+
+	if (Channel == 0xFF)
+		chan = USER_CHANNEL_LAST;
+	else
+	if (Channel > USER_CHANNEL_LAST)
+		chan = USER_CHANNEL_FIRST;
+	else
+		chan = Channel;
 
-	for (i = 0; i <= USER_CHANNEL_LAST; i++)
+	if (Direction == SCAN_STATE_DIR_OFF)
+		return (list[chan / 8] & (1u << (chan & 7u))) ? chan : 0xFF;
+
+	for (i = 0; i <= USER_CHANNEL_LAST; )
 	{
-		if (Channel == 0xFF)
-			Channel = USER_CHANNEL_LAST;
-		else
-		if (Channel > USER_CHANNEL_LAST)
-			Channel = USER_CHANNEL_FIRST;
+		const uint8_t bits = list[chan / 8];
 
-		if (RADIO_channel_valid(Channel, bCheckScanList, VFO))
-			return Channel;
+		if (bits == 0)
+		{	// nothing in this group of 8, jump to the next group
+			const unsigned int step = (Direction > 0) ? 8 - (chan & 7u) : (chan & 7u) + 1;
+			chan = (Direction > 0) ? chan + step : chan - step;
+			i   += step;
+		}
+		else
+		{
+			if (bits & (1u << (chan & 7u)))
+				return chan;
+			chan += Direction;
+			i++;
+		}
 
-		Channel += Direction;
+		if (chan > USER_CHANNEL_LAST)	// wrap-a-round (also catches going below 0)
+			chan = (Direction > 0) ? USER_CHANNEL_FIRST : USER_CHANNEL_LAST;
 	}
 
 	return 0xFF;
@@ -266,6 +304,7 @@ void RADIO_configure_channel(const unsigned int VFO, const unsigned int configur
 //		EEPROM_ReadBuffer(Base, &m_channel, sizeof(t_channel));
 
 //		EEPROM_ReadBuffer(Base, p_vfo->channel, sizeof(t_channel));
+		SETTINGS_need_channel(channel);
 		memcpy(&p_vfo->channel, &g_eeprom.config.channel[chan], sizeof(t_channel));
 
 		p_vfo->step_freq = STEP_FREQ_TABLE[p_vfo->channel.step_setting];
@@ -339,8 +378,11 @@ void RADIO_configure_channel(const unsigned int VFO, const unsigned int configur
 	// channel name
 	memset(&p_vfo->channel_name, 0, sizeof(p_vfo->channel_name));
 	if (channel <= USER_CHANNEL_LAST)
+	{
 //		EEPROM_ReadBuffer(0x0F50 + (channel * 16), p_vfo->channel_name, 10);	// only 10 bytes used
+		SETTINGS_need_channel(channel);
 		memcpy(p_vfo->channel_name.name, &g_eeprom.config.channel_name[channel].name, sizeof(p_vfo->channel_name.name));
+	}
 
 	if (p_vfo->channel.mod_mode != MOD_MODE_FM)
 	{	// freq/chan is in AM mode
@@ -436,125 +478,152 @@ void RADIO_configure_channel(const unsigned int VFO, const unsigned int configur
 	}
 #endif
 
-void RADIO_ConfigureSquelch(vfo_info_t *p_vfo)
+// open/close thresholds for each band group and squelch level 1 ~ 9, worked out
+// from the calibration data once rather than every time a channel's configured
+static squelch_thresh_t squelch_table[2][9];
+
+void RADIO_build_squelch_table(void)
 {
-	const unsigned int squelch_level = (p_vfo->channel.squelch_level > 0) ? p_vfo->channel.squelch_level : g_eeprom.config.setting.squelch_level;
+	unsigned int band;
+	unsigned int level;
 
 	// note that 'noise' and 'glitch' values are inverted compared to 'rssi' values
 
-	if (squelch_level == 0)
-	{	// squelch == 0 (off)
-		p_vfo->squelch_open_rssi_thresh    = 0;     // 0 ~ 255
-		p_vfo->squelch_close_rssi_thresh   = 0;     // 0 ~ 255
+	// my calibration data
+	//
+	// bands 4567
+	// 0A 4B 53 56 59 5C 5F 62 64 66 FF FF FF FF FF FF   // open rssi
+	// 05 46 50 53 56 59 5C 5F 62 64 FF FF FF FF FF FF   // close rssi
+	// 5A 2D 29 26 23 20 1D 1A 17 14 FF FF FF FF FF FF   // open noise
+	// 64 30 2D 29 26 23 20 1D 1A 17 FF FF FF FF FF FF   // close noise
+	// 5A 14 11 0E 0B 08 03 02 02 02 FF FF FF FF FF FF   // open glitch
+	// 64 11 0E 0B 08 05 05 04 04 04 FF FF FF FF FF FF   // close glitch
+	//
+	// bands 123
+	// 32 68 6B 6E 6F 72 75 77 79 7B FF FF FF FF FF FF   // open rssi
+	// 28 64 67 6A 6C 6E 71 73 76 78 FF FF FF FF FF FF   // close rssi
+	// 41 32 2D 28 24 21 1E 1A 17 16 FF FF FF FF FF FF   // open noise
+	// 46 37 32 2D 28 25 22 1E 1B 19 FF FF FF FF FF FF   // close noise
+	// 5A 19 0F 0A 09 08 07 06 05 04 FF FF FF FF FF FF   // open glitch
+	// 64 1E 14 0F 0D 0C 0B 0A 09 08 FF FF FF FF FF FF   // close glitch
+
+	for (band = 0; band < ARRAY_SIZE(squelch_table); band++)
+	{	// 0 = bands 4567, 1 = bands 123
+		for (level = 1; level <= ARRAY_SIZE(squelch_table[0]); level++)
+		{
+			squelch_thresh_t *p_thresh = &squelch_table[band][level - 1];
 
-		p_vfo->squelch_open_noise_thresh   = 127;   // 127 ~ 0
-		p_vfo->squelch_close_noise_thresh  = 127;   // 127 ~ 0
+			// only the 'open' levels are used, the 'close' levels are set from them below
 
-		p_vfo->squelch_open_glitch_thresh  = 255;   // 255 ~ 0
-		p_vfo->squelch_close_glitch_thresh = 255;   // 255 ~ 0
-	}
-	else
-	{	// squelch >= 1
+			int16_t rssi_open    = g_eeprom.calib.squelch_band[band].open_rssi_thresh[level];      // 0 ~ 255
+			int16_t noise_open   = g_eeprom.calib.squelch_band[band].open_noise_thresh[level];     // 127 ~ 0
+			int16_t glitch_open  = g_eeprom.calib.squelch_band[band].open_glitch_thresh[level];    // 255 ~ 0
 
-		// my calibration data
-		//
-		// bands 4567
-		// 0A 4B 53 56 59 5C 5F 62 64 66 FF FF FF FF FF FF   // open rssi
-		// 05 46 50 53 56 59 5C 5F 62 64 FF FF FF FF FF FF   // close rssi
-		// 5A 2D 29 26 23 20 1D 1A 17 14 FF FF FF FF FF FF   // open noise
-		// 64 30 2D 29 26 23 20 1D 1A 17 FF FF FF FF FF FF   // close noise
-		// 5A 14 11 0E 0B 08 03 02 02 02 FF FF FF FF FF FF   // open glitch
-		// 64 11 0E 0B 08 05 05 04 04 04 FF FF FF FF FF FF   // close glitch
-		//
-		// bands 123
-		// 32 68 6B 6E 6F 72 75 77 79 7B FF FF FF FF FF FF   // open rssi
-		// 28 64 67 6A 6C 6E 71 73 76 78 FF FF FF FF FF FF   // close rssi
-		// 41 32 2D 28 24 21 1E 1A 17 16 FF FF FF FF FF FF   // open noise
-		// 46 37 32 2D 28 25 22 1E 1B 19 FF FF FF FF FF FF   // close noise
-		// 5A 19 0F 0A 09 08 07 06 05 04 FF FF FF FF FF FF   // open glitch
-		// 64 1E 14 0F 0D 0C 0B 0A 09 08 FF FF FF FF FF FF   // close glitch
+			int16_t rssi_close;
+			int16_t noise_close;
+			int16_t glitch_close;
 
-		unsigned int band = (unsigned int)FREQUENCY_GetBand(p_vfo->p_rx->frequency);
-		band = (band < BAND4_174MHz) ? 1 : 0;
+			// *********
 
-		p_vfo->squelch_open_rssi_thresh    = g_eeprom.calib.squelch_band[band].open_rssi_thresh[squelch_level];
-		p_vfo->squelch_close_rssi_thresh   = g_eeprom.calib.squelch_band[band].close_rssi_thresh[squelch_level];
+			#if ENABLE_SQUELCH_MORE_SENSITIVE
+				// make squelch a little more sensitive
+				//
+				// getting the best general settings here is experimental, bare with me
 
-		p_vfo->squelch_open_noise_thresh   = g_eeprom.calib.squelch_band[band].open_noise_thresh[squelch_level];
-		p_vfo->squelch_close_noise_thresh  = g_eeprom.calib.squelch_band[band].close_noise_thresh[squelch_level];
+				#if 0
+					rssi_open   = (rssi_open   * 8) / 9;
+					noise_open  = (noise_open  * 9) / 8;
+					glitch_open = (glitch_open * 9) / 8;
+				#else
+					// even more sensitive .. use when RX bandwidths are fixed (no weak signal auto adjust)
+					rssi_open   = (rssi_open   * 1) / 2;
+					noise_open  = (noise_open  * 2) / 1;
+					glitch_open = (glitch_open * 2) / 1;
+				#endif
 
-		p_vfo->squelch_open_glitch_thresh  = g_eeprom.calib.squelch_band[band].open_glitch_thresh[squelch_level];
-		p_vfo->squelch_close_glitch_thresh = g_eeprom.calib.squelch_band[band].close_glitch_thresh[squelch_level];
+			#else
+				// more sensitive .. use when RX bandwidths are fixed (no weak signal auto adjust)
+				rssi_open   = (rssi_open   * 3) / 4;
+				noise_open  = (noise_open  * 4) / 3;
+				glitch_open = (glitch_open * 4) / 3;
+			#endif
 
-		// *********
+			// *********
+			// ensure the 'close' threshold is lower than the 'open' threshold
+			// ie, maintain a minimum level of hysteresis
 
-		int16_t rssi_open    = p_vfo->squelch_open_rssi_thresh;      // 0 ~ 255
-		int16_t rssi_close   = p_vfo->squelch_close_rssi_thresh;     // 0 ~ 255
+			rssi_close   = (rssi_open   * 4) / 6;
+			noise_close  = (noise_open  * 6) / 4;
+			glitch_close = (glitch_open * 6) / 4;
 
-		int16_t noise_open   = p_vfo->squelch_open_noise_thresh;     // 127 ~ 0
-		int16_t noise_close  = p_vfo->squelch_close_noise_thresh;    // 127 ~ 0
+			if (rssi_open  <  8)
+				rssi_open  =  8;
+			if (rssi_close > (rssi_open   - 8))
+				rssi_close =  rssi_open   - 8;
 
-		int16_t glitch_open  = p_vfo->squelch_open_glitch_thresh;    // 255 ~ 0
-		int16_t glitch_close = p_vfo->squelch_close_glitch_thresh;   // 255 ~ 0
+			if (noise_open  > (127 - 4))
+				noise_open  =  127 - 4;
+			if (noise_close < (noise_open  + 4))
+				noise_close =  noise_open  + 4;
 
-		// *********
+			if (glitch_open  > (255 - 8))
+				glitch_open  =  255 - 8;
+			if (glitch_close < (glitch_open + 8))
+				glitch_close =  glitch_open + 8;
 
-		#if ENABLE_SQUELCH_MORE_SENSITIVE
-			// make squelch a little more sensitive
-			//
-			// getting the best general settings here is experimental, bare with me
+			// *********
 
-			#if 0
-				rssi_open   = (rssi_open   * 8) / 9;
-				noise_open  = (noise_open  * 9) / 8;
-				glitch_open = (glitch_open * 9) / 8;
-			#else
-				// even more sensitive .. use when RX bandwidths are fixed (no weak signal auto adjust)
-				rssi_open   = (rssi_open   * 1) / 2;
-				noise_open  = (noise_open  * 2) / 1;
-				glitch_open = (glitch_open * 2) / 1;
-			#endif
+			p_thresh->open_rssi    = (rssi_open    > 255) ? 255 : (rssi_open    < 0) ? 0 : rssi_open;
+			p_thresh->close_rssi   = (rssi_close   > 255) ? 255 : (rssi_close   < 0) ? 0 : rssi_close;
 
-		#else
-			// more sensitive .. use when RX bandwidths are fixed (no weak signal auto adjust)
-			rssi_open   = (rssi_open   * 3) / 4;
-			noise_open  = (noise_open  * 4) / 3;
-			glitch_open = (glitch_open * 4) / 3;
-		#endif
+			p_thresh->open_noise   = (noise_open   > 127) ? 127 : (noise_open   < 0) ? 0 : noise_open;
+			p_thresh->close_noise  = (noise_close  > 127) ? 127 : (noise_close  < 0) ? 0 : noise_close;
 
-		// *********
-		// ensure the 'close' threshold is lower than the 'open' threshold
-		// ie, maintain a minimum level of hysteresis
+			p_thresh->open_glitch  = (glitch_open  > 255) ? 255 : (glitch_open  < 0) ? 0 : glitch_open;
+			p_thresh->close_glitch = (glitch_close > 255) ? 255 : (glitch_close < 0) ? 0 : glitch_close;
+		}
+	}
+}
 
-		rssi_close   = (rssi_open   * 4) / 6;
-		noise_close  = (noise_open  * 6) / 4;
-		glitch_close = (glitch_open * 6) / 4;
+const squelch_thresh_t *RADIO_squelch_thresh(const uint32_t frequency, unsigned int squelch_level)
+{	// NULL when the squelch is off
+	const unsigned int band = (FREQUENCY_GetBand(frequency) < BAND4_174MHz) ? 1 : 0;
 
-		if (rssi_open  <  8)
-			rssi_open  =  8;
-		if (rssi_close > (rssi_open   - 8))
-			rssi_close =  rssi_open   - 8;
+	if (squelch_level == 0)
+		return NULL;
 
-		if (noise_open  > (127 - 4))
-			noise_open  =  127 - 4;
-		if (noise_close < (noise_open  + 4))
-			noise_close =  noise_open  + 4;
+	if (squelch_level > ARRAY_SIZE(squelch_table[0]))
+		squelch_level = ARRAY_SIZE(squelch_table[0]);
 
-		if (glitch_open  > (255 - 8))
-			glitch_open  =  255 - 8;
-		if (glitch_close < (glitch_open + 8))
-			glitch_close =  glitch_open + 8;
+	return &squelch_table[band][squelch_level - 1];
+}
 
-		// *********
+void RADIO_ConfigureSquelch(vfo_info_t *p_vfo)
+{
+	const unsigned int      squelch_level = (p_vfo->channel.squelch_level > 0) ? p_vfo->channel.squelch_level : g_eeprom.config.setting.squelch_level;
+	const squelch_thresh_t *p_thresh      = RADIO_squelch_thresh(p_vfo->p_rx->frequency, squelch_level);
 
-		p_vfo->squelch_open_rssi_thresh    = (rssi_open    > 255) ? 255 : (rssi_open    < 0) ? 0 : rssi_open;
-		p_vfo->squelch_close_rssi_thresh   = (rssi_close   > 255) ? 255 : (rssi_close   < 0) ? 0 : rssi_close;
+	if (p_thresh == NULL)
+	{	// squelch == 0 (off)
+		p_vfo->squelch_open_rssi_thresh    = 0;     // 0 ~ 255
+		p_vfo->squelch_close_rssi_thresh   = 0;     // 0 ~ 255
 
-		p_vfo->squelch_open_noise_thresh   = (noise_open   > 127) ? 127 : (noise_open   < 0) ? 0 : noise_open;
-		p_vfo->squelch_close_noise_thresh  = (noise_close  > 127) ? 127 : (noise_close  < 0) ? 0 : noise_close;
+		p_vfo->squelch_open_noise_thresh   = 127;   // 127 ~ 0
+		p_vfo->squelch_close_noise_thresh  = 127;   // 127 ~ 0
 
-		p_vfo->squelch_open_glitch_thresh  = (glitch_open  > 255) ? 255 : (glitch_open  < 0) ? 0 : glitch_open;
-		p_vfo->squelch_close_glitch_thresh = (glitch_close > 255) ? 255 : (glitch_close < 0) ? 0 : glitch_close;
+		p_vfo->squelch_open_glitch_thresh  = 255;   // 255 ~ 0
+		p_vfo->squelch_close_glitch_thresh = 255;   // 255 ~ 0
+	}
+	else
+	{	// squelch >= 1
+		p_vfo->squelch_open_rssi_thresh    = p_thresh->open_rssi;
+		p_vfo->squelch_close_rssi_thresh   = p_thresh->close_rssi;
+
+		p_vfo->squelch_open_noise_thresh   = p_thresh->open_noise;
+		p_vfo->squelch_close_noise_thresh  = p_thresh->close_noise;
+
+		p_vfo->squelch_open_glitch_thresh  = p_thresh->open_glitch;
+		p_vfo->squelch_close_glitch_thresh = p_thresh->close_glitch;
 	}
 }
 
@@ -691,6 +760,62 @@ BK4819_filter_bandwidth_t RADIO_set_bandwidth(BK4819_filter_bandwidth_t bandwidt
 	return bandwidth;
 }
 
+#ifdef ENABLE_SCAN_RANGES
+	void RADIO_select_scan_range(const unsigned int index)
+	{	// move the frequency scan on to one of the stored scan ranges
+		//
+		// only the filter bandwidth/AFC and the front end gain control are set up here (if the
+		// range needs them changing), the squelch is set up by the caller once the frequency
+		// is in the new range
+		const t_scan_range *range = &g_eeprom.scan_range[index];
+		vfo_info_t         *p_vfo = g_tx_vfo;
+
+		g_scan_range_index       = index;
+		g_scan_initial_step_size = STEP_FREQ_TABLE[range->step_setting];
+		g_scan_initial_lower     = range->lower;
+		g_scan_initial_upper     = range->lower + (range->steps * g_scan_initial_step_size);
+
+		p_vfo->channel.step_setting = range->step_setting;
+		p_vfo->step_freq            = g_scan_initial_step_size;
+
+		if (p_vfo->channel.mod_mode != range->mod_mode || p_vfo->channel.channel_bandwidth != range->bandwidth)
+		{
+			const bool mod_mode_changed = p_vfo->channel.mod_mode != range->mod_mode;
+
+			p_vfo->channel.mod_mode          = range->mod_mode;
+			p_vfo->channel.channel_bandwidth = range->bandwidth;
+			RADIO_set_bandwidth(p_vfo->channel.channel_bandwidth, p_vfo->channel.mod_mode);
+
+			if (mod_mode_changed)
+			{	// the front end gain control goes with the mode, as RADIO_configure_channel() sets it up
+				#ifdef ENABLE_AM_FIX
+					AM_fix_reset(g_eeprom.config.setting.tx_vfo_num);
+
+					if (p_vfo->channel.mod_mode != MOD_MODE_FM && g_eeprom.config.setting.am_fix)
+					{
+						AM_fix_10ms(g_eeprom.config.setting.tx_vfo_num);
+					}
+					else
+					{  // don't do agc in FM mode
+						BK4819_DisableAGC();
+						BK4819_write_reg(0x13, (g_orig_lnas << 8) | (g_orig_lna << 5) | (g_orig_mixer << 3) | (g_orig_pga << 0));
+					}
+				#else
+					if (p_vfo->channel.mod_mode != MOD_MODE_FM)
+					{
+						BK4819_EnableAGC();
+					}
+					else
+					{  // don't do agc in FM mode
+						BK4819_DisableAGC();
+						BK4819_write_reg(0x13, (g_orig_lnas << 8) | (g_orig_lna << 5) | (g_orig_mixer << 3) | (g_orig_pga << 0));
+					}
+				#endif
+			}
+		}
+	}
+#endif
+
 void RADIO_setup_registers(bool switch_to_function_foreground)
 {
 	BK4819_filter_bandwidth_t Bandwidth = g_rx_vfo->channel.channel_bandwidth;
@@ -951,15 +1076,11 @@ void RADIO_enableTX(const bool fsk_tx)
 
 	Bandwidth = RADIO_set_bandwidth(Bandwidth, g_current_vfo->channel.mod_mode);
 
-	// if DTMF is enabled when TX'ing, it changes the TX audio filtering ! .. 1of11
-	// so MAKE SURE that DTMF is disabled - until needed
-	BK4819_DisableDTMF();
-
 	BK4819_SetCompander((!fsk_tx && g_rx_vfo->channel.mod_mode == MOD_MODE_FM && (g_rx_vfo->channel.compand == 1 || g_rx_vfo->channel.compand >= 3)) ? g_rx_vfo->channel.compand : 0);
 
 	BK4819_set_rf_frequency(g_current_vfo->p_tx->frequency, true);
 	BK4819_set_rf_filter_path(g_current_vfo->p_tx->frequency);
-	BK4819_PrepareTransmit();
+	BK4819_PrepareTransmit();                                              // DTMF off, TX mute off, TX link on
 	RADIO_ConfigureTXPower(g_current_vfo);
 	BK4819_set_GPIO_pin(BK4819_GPIO1_PIN29_PA_ENABLE, true);                // PA on
 	if (g_current_display_screen != DISPLAY_AIRCOPY)
@@ -20,9 +20,19 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "driver/bk4819.h"
 #include "frequencies.h"
 #include "settings.h"
 
+typedef struct {
+	uint8_t open_rssi;
+	uint8_t close_rssi;
+	uint8_t open_noise;
+	uint8_t close_noise;
+	uint8_t open_glitch;
+	uint8_t close_glitch;
+} squelch_thresh_t;
+
 extern vfo_info_t      g_vfo_info[2];
 
 extern vfo_info_t     *g_tx_vfo;
@@ -35,6 +45,8 @@ extern uint8_t         g_selected_code;
 
 extern vfo_state_t     g_vfo_state[2];
 
+void     RADIO_update_scan_index(const unsigned int channel);
+void     RADIO_build_scan_index(void);
 bool     RADIO_channel_valid(uint16_t ChNum, bool bCheckScanList, uint8_t RadioNum);
 uint8_t  RADIO_FindNextChannel(uint8_t ChNum, scan_state_dir_t Direction, bool bCheckScanList, uint8_t RadioNum);
 void     RADIO_InitInfo(vfo_info_t *p_vfo, const uint8_t ChannelSave, const uint32_t Frequency);
@@ -42,11 +54,17 @@ void     RADIO_configure_channel(const unsigned int VFO, const unsigned int conf
 #ifdef ENABLE_VOX
 	void RADIO_enable_vox(unsigned int level);
 #endif
+void     RADIO_build_squelch_table(void);
+const squelch_thresh_t *RADIO_squelch_thresh(const uint32_t frequency, unsigned int squelch_level);
 void     RADIO_ConfigureSquelch(vfo_info_t *p_vfo);
 void     RADIO_ConfigureTXPower(vfo_info_t *p_vfo);
 void     RADIO_apply_offset(vfo_info_t *p_vfo, const bool set_pees);
 void     RADIO_select_vfos(void);
 void     RADIO_setup_registers(bool switch_to_function_foreground);
+BK4819_filter_bandwidth_t RADIO_set_bandwidth(BK4819_filter_bandwidth_t bandwidth, const int mode);
+#ifdef ENABLE_SCAN_RANGES
+	void RADIO_select_scan_range(const unsigned int index);
+#endif
 #ifdef ENABLE_NOAA
 	void RADIO_ConfigureNOAA(void);
 #endif
@@ -0,0 +1,131 @@
+
+#include <string.h>
+
+#include "dcs.h"
+#include "driver/bk4819.h"
+#include "functions.h"
+#include "misc.h"
+#include "radio.h"
+#include "scan_log.h"
+#include "settings.h"
+
+// RAM ring buffer of the signals the scan has stopped on, for band occupancy surveys
+//
+// the latest hit is kept up to date for as long as the squelch stays open on it
+
+static scan_log_entry_t scan_log[SCAN_LOG_SIZE];
+static unsigned int     scan_log_next  = 0;       // where the next hit goes
+static unsigned int     scan_log_count = 0;
+static bool             scan_log_open  = false;   // the latest hit is still being received
+static uint8_t          scan_log_ctcss = 0xff;    // CTCSS tone the last read found, 0xff = none
+
+static uint16_t SCAN_LOG_rssi(void)
+{	// the AM fix gain compensation can take it below zero
+	const int16_t rssi = g_current_rssi[g_rx_vfo_num];
+	return (rssi > 0) ? rssi : 0;
+}
+
+static void SCAN_LOG_css(scan_log_entry_t *entry)
+{	// the chip measures whatever sub-audible tone/code the signal carries, whatever the VFO is set
+	// to listen for .. the same result the CTCSS/DCS search works from. a DCS code is Golay
+	// checked so one read will do, a CTCSS tone has to read the same twice running
+	uint32_t cdcss;
+	uint16_t ctcss_freq;
+	uint8_t  code;
+
+	switch (BK4819_GetCxCSSScanResult(&cdcss, &ctcss_freq))
+	{
+		case BK4819_CSS_RESULT_CDCSS:
+			code = DCS_GetCdcssCode(cdcss);
+			if (code != 0xff)
+			{
+				entry->code_type = CODE_TYPE_DIGITAL;
+				entry->code      = code;
+			}
+			scan_log_ctcss = 0xff;
+			break;
+
+		case BK4819_CSS_RESULT_CTCSS:
+			code = DCS_GetCtcssCode(ctcss_freq);
+			if (code != 0xff && code == scan_log_ctcss)
+			{
+				entry->code_type = CODE_TYPE_CONTINUOUS_TONE;
+				entry->code      = code;
+			}
+			scan_log_ctcss = code;
+			break;
+
+		default:
+			scan_log_ctcss = 0xff;
+			break;
+	}
+}
+
+void SCAN_LOG_clear(void)
+{
+	scan_log_next  = 0;
+	scan_log_count = 0;
+	scan_log_open  = false;
+}
+
+void SCAN_LOG_hit(void)
+{	// the scan has just stopped on a signal
+	scan_log_entry_t *entry = &scan_log[scan_log_next];
+
+	entry->frequency     = g_rx_vfo->p_rx->frequency;
+	entry->tick_10ms     = g_global_sys_tick_counter;
+	entry->duration_10ms = 0;
+	entry->rssi_peak     = SCAN_LOG_rssi();
+	entry->noise_min     = g_current_noise[g_rx_vfo_num];
+	entry->channel       = IS_USER_CHANNEL(g_rx_vfo->channel_save) ? g_rx_vfo->channel_save : 0xff;
+	entry->code_type     = CODE_TYPE_NONE;
+	entry->code          = 0;
+
+	scan_log_next = (scan_log_next + 1) % SCAN_LOG_SIZE;
+	if (scan_log_count < SCAN_LOG_SIZE)
+		scan_log_count++;
+
+	scan_log_open  = true;
+	scan_log_ctcss = 0xff;
+}
+
+void SCAN_LOG_10ms(void)
+{	// follow the latest hit until the squelch closes on it
+	scan_log_entry_t *entry;
+
+	if (!scan_log_open)
+		return;
+
+	if (!g_squelch_open || (g_current_function != FUNCTION_RECEIVE && g_current_function != FUNCTION_NEW_RECEIVE))
+	{
+		scan_log_open = false;
+		return;
+	}
+
+	entry = &scan_log[(scan_log_next + SCAN_LOG_SIZE - 1) % SCAN_LOG_SIZE];
+
+	if (entry->duration_10ms < 0xffff)
+		entry->duration_10ms++;
+
+	if (entry->rssi_peak < SCAN_LOG_rssi())
+		entry->rssi_peak = SCAN_LOG_rssi();
+
+	if (entry->noise_min > g_current_noise[g_rx_vfo_num])
+		entry->noise_min = g_current_noise[g_rx_vfo_num];
+
+	if (entry->code_type == CODE_TYPE_NONE)
+		SCAN_LOG_css(entry);
+}
+
+unsigned int SCAN_LOG_count(void)
+{
+	return scan_log_count;
+}
+
+const scan_log_entry_t *SCAN_LOG_entry(const unsigned int index)
+{	// 0 = the oldest hit
+	if (index >= scan_log_count)
+		return NULL;
+
+	return &scan_log[(scan_log_next + SCAN_LOG_SIZE - scan_log_count + index) % SCAN_LOG_SIZE];
+}
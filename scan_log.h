@@ -0,0 +1,30 @@
+
+#ifndef SCAN_LOG_H
+#define SCAN_LOG_H
+
+#include <stdint.h>
+
+#ifdef ENABLE_SCAN_LOG
+	// how many hits the log holds, the oldest is dropped when it's full
+	#define SCAN_LOG_SIZE   32
+
+	// one signal the scan stopped on, 16 bytes
+	typedef struct {
+		uint32_t frequency;       // 10Hz units
+		uint32_t tick_10ms;       // g_global_sys_tick_counter when the scan stopped on it
+		uint16_t duration_10ms;   // how long the squelch stayed open, saturates
+		uint16_t rssi_peak;       // highest RSSI seen, 0.5dB steps (dBm = (rssi / 2) - 160)
+		uint8_t  noise_min;       // lowest noise indicator seen
+		uint8_t  channel;         // user channel, 0xff = frequency scan
+		uint8_t  code_type;       // CODE_TYPE_NONE if no CTCSS/DCS was decoded
+		uint8_t  code;            // CTCSS/DCS index
+	} __attribute__((packed)) scan_log_entry_t;
+
+	void                    SCAN_LOG_clear(void);
+	void                    SCAN_LOG_hit(void);
+	void                    SCAN_LOG_10ms(void);
+	unsigned int            SCAN_LOG_count(void);
+	const scan_log_entry_t *SCAN_LOG_entry(const unsigned int index);
+#endif
+
+#endif
@@ -41,7 +41,7 @@
 				flag = true;             \
 	} while (0)
 
-static volatile uint32_t g_global_sys_tick_counter;
+volatile uint32_t g_global_sys_tick_counter;
 
 void SystickHandler(void);
 
@@ -14,6 +14,8 @@
  *     limitations under the License.
  */
 
+#include <stddef.h>     // offsetof
+
 #include "app/dtmf.h"
 #ifdef ENABLE_FMRADIO
 	#include "app/fm.h"
@@ -21,10 +23,15 @@
 #endif
 #include "driver/bk4819.h"
 #include "driver/eeprom.h"
+#ifdef ENABLE_SCAN_IGNORE_LIST
+	#include "freq_ignore.h"
+#endif
 #if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
 	#include "driver/uart.h"
 #endif
+#include "helper/boot.h"
 #include "misc.h"
+#include "profile.h"
 #include "radio.h"
 #include "settings.h"
 #include "ui/menu.h"
@@ -43,9 +50,176 @@ static const uint32_t DEFAULT_FREQUENCY_TABLE[] =
 
 t_eeprom g_eeprom;
 
+// the settings, VFO channels, channel attributes and calibration are always read at
+// boot, with ENABLE_FAST_BOOT the user channels, their names, the DTMF contacts and
+// the scan ranges/ignore list follow on in the background, user channels first
+#define DEFERRED_CHUNK       128
+#define DEFERRED_GAP_START   offsetof(t_config, vfo_channel)
+#define DEFERRED_GAP_END     offsetof(t_config, channel_name)
+#define DEFERRED_END         offsetof(t_eeprom, calib)
+
+static unsigned int deferred_addr = DEFERRED_END;   // next address to load, DEFERRED_END = all loaded
+#ifdef ENABLE_FAST_BOOT
+	static uint8_t boot_channel[2] = {0xff, 0xff};   // the user channels read at boot ahead of the rest
+#endif
+
+// the settings and channel attributes are edited in place in g_eeprom, so these hold
+// what was last read from or saved to the chip for them, a save then only queues the
+// blocks that differ (the EEPROM driver writes out whatever it's handed from g_eeprom)
+static typeof(g_eeprom.config.setting)            saved_setting;
+static typeof(g_eeprom.config.channel_attributes) saved_attributes;
+
+static void SETTINGS_read_range(const unsigned int start, const unsigned int end)
+{
+	unsigned int index;
+	for (index = start; index < end; index += DEFERRED_CHUNK)
+		EEPROM_ReadBuffer(index, (uint8_t *)&g_eeprom + index, (end - index < DEFERRED_CHUNK) ? end - index : DEFERRED_CHUNK);
+}
+
+static void SETTINGS_save_changed(const void *p_data, void *p_saved, const unsigned int size)
+{	// queue the blocks of an in place edited part of g_eeprom that differ from what was last saved
+	const uint16_t addr = (uint16_t)((const uint8_t *)p_data - (const uint8_t *)&g_eeprom);
+	unsigned int   i;
+
+	for (i = 0; i < size; i += 8)
+	{
+		const unsigned int len = (size - i < 8) ? size - i : 8;
+
+		if (memcmp((const uint8_t *)p_data + i, (uint8_t *)p_saved + i, len) != 0)
+		{
+			memcpy((uint8_t *)p_saved + i, (const uint8_t *)p_data + i, len);
+			EEPROM_WriteBuffer(addr + i, (const uint8_t *)p_data + i, len);
+		}
+	}
+}
+
+static void SETTINGS_clean_channel(const unsigned int index)
+{
+	if (g_eeprom.config.channel_attributes[index].band > BAND7_470MHz)
+	{	// unused channel
+		g_eeprom.config.channel_attributes[index].attributes = 0xff;
+		memset(&g_eeprom.config.user_channel[index], 0xff, sizeof(g_eeprom.config.user_channel[index]));
+		memset(&g_eeprom.config.channel_name[index], 0xff, sizeof(g_eeprom.config.channel_name[index]));
+	}
+	else
+	{	// used channel
+		g_eeprom.config.channel_attributes[index].unused = 0x00;
+		memset(g_eeprom.config.channel_name[index].unused, 0x00, sizeof(g_eeprom.config.channel_name[index].unused));
+
+		// ensure the channel band attribute is correct
+		if (g_eeprom.config.channel[index].frequency > 0 && g_eeprom.config.channel[index].frequency < 0xffffffff)
+			g_eeprom.config.channel_attributes[index].band = FREQUENCY_GetBand(g_eeprom.config.channel[index].frequency);
+	}
+}
+
+static void SETTINGS_clean_channels(void)
+{
+	unsigned int index;
+
+	#ifdef ENABLE_SCAN_IGNORE_LIST
+		FI_load();
+	#else
+		memset(&g_eeprom.config.unused13, 0xff, sizeof(g_eeprom.config.unused13));
+		#ifndef ENABLE_SCAN_RANGES
+			memset(&g_eeprom.unused14, 0xff, sizeof(g_eeprom.unused14));
+		#endif
+		memset(&g_eeprom.unused, 0xff, sizeof(g_eeprom.unused));
+	#endif
+
+	// clear out unused channels
+	for (index = 0; index < 200; index++)
+		SETTINGS_clean_channel(index);
+
+	// force default VFO attributes
+	for (index = 200; index < 207; index++)
+		g_eeprom.config.channel_attributes[index].attributes = 0xC0 | (index - 200);
+	g_eeprom.config.channel_attributes[207].attributes = 0x00;
+
+	SETTINGS_save_attributes();
+
+	RADIO_build_scan_index();
+}
+
+#ifdef ENABLE_FAST_BOOT
+	static void SETTINGS_read_active_channels(void)
+	{	// the user channels the VFO's are going to come up on
+		unsigned int vfo;
+
+		for (vfo = 0; vfo < ARRAY_SIZE(g_eeprom.config.setting.indices.vfo); vfo++)
+		{
+			unsigned int channel = g_eeprom.config.setting.indices.vfo[vfo].screen;
+
+			if (!IS_USER_CHANNEL(channel))
+				continue;
+
+			// RADIO_configure_channel() moves on to the next valid channel if this one isn't
+			channel = RADIO_FindNextChannel(channel, SCAN_STATE_DIR_FORWARD, false, vfo);
+			if (!IS_USER_CHANNEL(channel))
+				continue;
+
+			EEPROM_ReadBuffer(offsetof(t_config, channel) + (channel * sizeof(t_channel)), &g_eeprom.config.channel[channel], sizeof(t_channel));
+			EEPROM_ReadBuffer(offsetof(t_config, channel_name) + (channel * sizeof(t_channel_name)), &g_eeprom.config.channel_name[channel], sizeof(t_channel_name));
+
+			SETTINGS_clean_channel(channel);
+			boot_channel[vfo] = channel;
+		}
+	}
+#endif
+
+void SETTINGS_load_deferred(void)
+{	// load the next chunk of what SETTINGS_read_eeprom() left out
+	unsigned int end;
+	unsigned int vfo;
+
+	if (deferred_addr >= DEFERRED_END)
+		return;
+
+	end = (deferred_addr < DEFERRED_GAP_START) ? DEFERRED_GAP_START : DEFERRED_END;
+	if (end > deferred_addr + DEFERRED_CHUNK)
+		end = deferred_addr + DEFERRED_CHUNK;
+
+	SETTINGS_read_range(deferred_addr, end);
+
+	deferred_addr = (end == DEFERRED_GAP_START) ? DEFERRED_GAP_END : end;
+	if (deferred_addr < DEFERRED_END)
+		return;
+
+	SETTINGS_clean_channels();
+
+	// the VFO's "frequency is in channel x" lookups were done without the user channels
+	for (vfo = 0; vfo < ARRAY_SIZE(g_vfo_info); vfo++)
+		if (IS_FREQ_CHANNEL(g_vfo_info[vfo].channel_save))
+			g_vfo_info[vfo].freq_in_channel = SETTINGS_find_channel(g_vfo_info[vfo].freq_config_rx.frequency);
+	g_update_display = true;
+
+	BOOT_timestamp(BOOT_PHASE_EEPROM);
+}
+
+void SETTINGS_load_deferred_all(void)
+{
+	while (deferred_addr < DEFERRED_END)
+		SETTINGS_load_deferred();
+}
+
+void SETTINGS_need_channel(const unsigned int channel)
+{	// the one check everything reading a user channel or it's name out of the mirror goes
+	// through first .. if the background load hasn't got to it yet, finish the load now
+	if (deferred_addr >= DEFERRED_END || !IS_USER_CHANNEL(channel))
+		return;
+
+	#ifdef ENABLE_FAST_BOOT
+		if (channel == boot_channel[0] || channel == boot_channel[1])
+			return;
+	#endif
+
+	SETTINGS_load_deferred_all();
+}
+
 void SETTINGS_write_eeprom_config(void)
 {	// save the entire EEPROM config contents
 	unsigned int index;
+
+	SETTINGS_load_deferred_all();
 	for (index = 0; index < sizeof(g_eeprom.config); index += 8)
 		EEPROM_WriteBuffer8(index, ((uint8_t *)&g_eeprom) + index);
 }
@@ -53,55 +227,62 @@ void SETTINGS_write_eeprom_config(void)
 #ifdef ENABLE_FMRADIO
 	void SETTINGS_save_fm(void)
 	{
-		unsigned int i;
-		unsigned int index;
+		PROFILE_start(PROFILE_SETTINGS_SAVE);
 
-		index = (unsigned int)(((uint8_t *)&g_eeprom.config.setting.fm_radio) - ((uint8_t *)&g_eeprom));
-		EEPROM_WriteBuffer8(index, &g_eeprom.config.setting.fm_radio);
+		SETTINGS_save_changed(&g_eeprom.config.setting.fm_radio, &saved_setting.fm_radio, 8);
+		SETTINGS_save_changed(&g_eeprom.config.setting.fm_channel, &saved_setting.fm_channel, sizeof(g_eeprom.config.setting.fm_channel));
 
-		index = (unsigned int)(((uint8_t *)&g_eeprom.config.setting.fm_channel) - ((uint8_t *)&g_eeprom));
-		for (i = 0; i < sizeof(g_eeprom.config.setting.fm_channel); i += 8)
-			EEPROM_WriteBuffer8(index + i, ((uint8_t *)&g_eeprom.config.setting.fm_channel) + i);
+		PROFILE_stop(PROFILE_SETTINGS_SAVE);
 	}
 #endif
 
 void SETTINGS_save_vfo_indices(void)
 {
-	const uint16_t index = (uint16_t)(((uint8_t *)&g_eeprom.config.setting.indices) - ((uint8_t *)&g_eeprom));
-	EEPROM_WriteBuffer8(index, &g_eeprom.config.setting.indices);
+	PROFILE_start(PROFILE_SETTINGS_SAVE);
+	SETTINGS_save_changed(&g_eeprom.config.setting.indices, &saved_setting.indices, 8);
+	PROFILE_stop(PROFILE_SETTINGS_SAVE);
 }
 
 void SETTINGS_save_attributes(void)
 {
-	unsigned int i;
-	const unsigned int index = (unsigned int )(((uint8_t *)&g_eeprom.config.channel_attributes) - ((uint8_t *)&g_eeprom));
-	for (i = 0; i < sizeof(g_eeprom.config.channel_attributes); i += 8)
-		EEPROM_WriteBuffer8(index + i, ((uint8_t *)&g_eeprom.config.channel_attributes) + i);
+	PROFILE_start(PROFILE_SETTINGS_SAVE);
+	SETTINGS_save_changed(&g_eeprom.config.channel_attributes, &saved_attributes, sizeof(g_eeprom.config.channel_attributes));
+	PROFILE_stop(PROFILE_SETTINGS_SAVE);
 }
 
 void SETTINGS_save_channel_names(void)
 {
 	unsigned int i;
 	const unsigned int index = (unsigned int)(((uint8_t *)&g_eeprom.config.channel_name) - ((uint8_t *)&g_eeprom));
+	SETTINGS_load_deferred_all();   // every name goes back, they all have to be in
+	PROFILE_start(PROFILE_SETTINGS_SAVE);
 	for (i = 0; i < sizeof(g_eeprom.config.channel_name); i += 8)
 		EEPROM_WriteBuffer8(index + i, ((uint8_t *)&g_eeprom.config.channel_name) + i);
+	PROFILE_stop(PROFILE_SETTINGS_SAVE);
 }
 
 void SETTINGS_read_eeprom(void)
 {
-	unsigned int index;
+	#ifdef ENABLE_FAST_BOOT
+		// just what's needed to get on the air, SETTINGS_load_deferred() brings in the rest
+		SETTINGS_read_range(DEFERRED_GAP_START, DEFERRED_GAP_END);
+		SETTINGS_read_range(offsetof(t_eeprom, calib), sizeof(g_eeprom));
+		deferred_addr = 0;
+	#else
+		// read the entire EEPROM contents into memory as a whole
+		SETTINGS_read_range(0, sizeof(g_eeprom));
+	#endif
 
-	// read the entire EEPROM contents into memory as a whole
-	for (index = 0; index < sizeof(g_eeprom); index += 128)
-		EEPROM_ReadBuffer(index, (uint8_t *)(&g_eeprom) + index, 128);
+	memcpy(&saved_setting,    &g_eeprom.config.setting,            sizeof(saved_setting));
+	memcpy(&saved_attributes, &g_eeprom.config.channel_attributes, sizeof(saved_attributes));
 
 	#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
 		UART_printf("config size %04X %u\r\n"
-		            "unused size %04X %u\r\n"
+		            "other  size %04X %u\r\n"
 		            "calib  size %04X %u\r\n"
 		            "eeprom size %04X %u\r\n",
 		             sizeof(g_eeprom.config), sizeof(g_eeprom.config),
-					 sizeof(g_eeprom.unused), sizeof(g_eeprom.unused),
+					 offsetof(t_eeprom, calib) - sizeof(g_eeprom.config), offsetof(t_eeprom, calib) - sizeof(g_eeprom.config),
 					 sizeof(g_eeprom.calib),  sizeof(g_eeprom.calib),
 					 sizeof(g_eeprom),        sizeof(g_eeprom));
 	#endif
@@ -167,6 +348,9 @@ void SETTINGS_read_eeprom(void)
 	g_eeprom.config.setting.carrier_search_mode = (g_eeprom.config.setting.carrier_search_mode < 3) ? g_eeprom.config.setting.carrier_search_mode : SCAN_RESUME_CARRIER;
 	g_eeprom.config.setting.auto_key_lock       = (g_eeprom.config.setting.auto_key_lock < 2)       ? g_eeprom.config.setting.auto_key_lock : 0;
 	g_eeprom.config.setting.power_on_display_mode = (g_eeprom.config.setting.power_on_display_mode < 4) ? g_eeprom.config.setting.power_on_display_mode : PWR_ON_DISPLAY_MODE_VOLTAGE;
+	#ifdef ENABLE_PANADAPTER
+		g_eeprom.config.setting.panadapter_revisit = (g_eeprom.config.setting.panadapter_revisit < 3) ? g_eeprom.config.setting.panadapter_revisit : 0;
+	#endif
 
 	// 0EA0..0EA7
 	#ifdef ENABLE_VOICE
@@ -183,6 +367,7 @@ void SETTINGS_read_eeprom(void)
 	#if defined(ENABLE_AIRCOPY) && defined(ENABLE_AIRCOPY_REMEMBER_FREQ)
 		if (g_eeprom.config.setting.air_copy_freq > 0 && g_eeprom.config.setting.air_copy_freq < 0xffffffff)
 		{
+			unsigned int index;
 			for (index = 0; index < ARRAY_SIZE(FREQ_BAND_TABLE); index++)
 				if (g_eeprom.config.setting.air_copy_freq >= FREQ_BAND_TABLE[index].lower && g_eeprom.config.setting.air_copy_freq < FREQ_BAND_TABLE[index].upper)
 					break;
@@ -324,41 +509,16 @@ void SETTINGS_read_eeprom(void)
 
 	// 0F48..0F4F
 	g_eeprom.config.setting.scan_hold_time = (g_eeprom.config.setting.scan_hold_time > 40) ? 6 : (g_eeprom.config.setting.scan_hold_time < 2) ? 6 : g_eeprom.config.setting.scan_hold_time;
+	g_eeprom.config.setting.priority_look_back = (g_eeprom.config.setting.priority_look_back > 50) ? 0 : g_eeprom.config.setting.priority_look_back;
 
 	// ****************************************
 	// EEPROM cleaning
 
-#if 1
-	memset(&g_eeprom.config.unused13, 0xff, sizeof(g_eeprom.config.unused13));
-
-	memset(&g_eeprom.unused, 0xff, sizeof(g_eeprom.unused));
-
-	// clear out unused channels
-	for (index = 0; index < 200; index++)
-	{
-		if (g_eeprom.config.channel_attributes[index].band > BAND7_470MHz)
-		{	// unused channel
-			g_eeprom.config.channel_attributes[index].attributes = 0xff;
-			memset(&g_eeprom.config.user_channel[index], 0xff, sizeof(g_eeprom.config.user_channel[index]));
-			memset(&g_eeprom.config.channel_name[index], 0xff, sizeof(g_eeprom.config.channel_name[index]));
-		}
-		else
-		{	// used channel
-			g_eeprom.config.channel_attributes[index].unused = 0x00;
-			memset(g_eeprom.config.channel_name[index].unused, 0x00, sizeof(g_eeprom.config.channel_name[index].unused));
-
-			// ensure the channel band attribute is correct
-			if (g_eeprom.config.channel[index].frequency > 0 && g_eeprom.config.channel[index].frequency < 0xffffffff)
-				g_eeprom.config.channel_attributes[index].band = FREQUENCY_GetBand(g_eeprom.config.channel[index].frequency);
-		}
-	}
-
-	// force default VFO attributes
-	for (index = 200; index < 207; index++)
-		g_eeprom.config.channel_attributes[index].attributes = 0xC0 | (index - 200);
-	g_eeprom.config.channel_attributes[207].attributes = 0x00;
-
-	SETTINGS_save_attributes();
+#ifdef ENABLE_FAST_BOOT
+	RADIO_build_scan_index();          // the attributes are in, good enough to find the channels with
+	SETTINGS_read_active_channels();   // the rest are cleaned once they're loaded
+#else
+	SETTINGS_clean_channels();
 #endif
 
 	// ****************************************
@@ -385,12 +545,14 @@ void SETTINGS_read_eeprom(void)
 	BK4819_write_reg(0x3B, 22656 + g_eeprom.calib.bk4819_xtal_freq_low);
 //	BK4819_write_reg(0x3C, g_eeprom.calib.BK4819_XTAL_FREQ_HIGH);
 
+	RADIO_build_squelch_table();
+
 	// ****************************************
 }
 
 void SETTINGS_save(void)
 {
-	uint32_t index;
+	PROFILE_start(PROFILE_SETTINGS_SAVE);
 
 	#ifndef ENABLE_KEYLOCK
 		g_eeprom.config.setting.key_lock = 0;
@@ -426,11 +588,9 @@ void SETTINGS_save(void)
 		g_eeprom.config.setting.radio_disabled = 0;
 	#endif
 
-	for (index = 0; index < sizeof(g_eeprom.config.setting); index += 8)
-	{
-		const uint16_t offset = (uint16_t)(((uint8_t *)&g_eeprom.config.setting) - ((uint8_t *)&g_eeprom));
-		EEPROM_WriteBuffer8(offset + index, ((uint8_t *)&g_eeprom.config.setting) + index);
-	}
+	SETTINGS_save_changed(&g_eeprom.config.setting, &saved_setting, sizeof(g_eeprom.config.setting));
+
+	PROFILE_stop(PROFILE_SETTINGS_SAVE);
 }
 
 void SETTINGS_save_channel(const unsigned int channel, const unsigned int vfo, vfo_info_t *p_vfo, const unsigned int mode)
@@ -454,6 +614,8 @@ void SETTINGS_save_channel(const unsigned int channel, const unsigned int vfo, v
 	if (mode < 2 && channel <= USER_CHANNEL_LAST)
 		return;
 
+	PROFILE_start(PROFILE_SETTINGS_SAVE);
+
 	{	// save the channel to EEPROM
 
 		const unsigned int chan = CHANNEL_NUM(channel, vfo);
@@ -470,8 +632,7 @@ void SETTINGS_save_channel(const unsigned int channel, const unsigned int vfo, v
 			UART_printf("save chan 2 %04X  %3u %3u %u %u %uHz %uHz\r\n", addr, chan, channel, vfo, mode, m_channel.frequency * 10, m_channel.tx_offset * 10);
 		#endif
 
-		memcpy(&g_eeprom.config.channel[chan], &m_channel, sizeof(t_channel));
-
+		// g_eeprom.config.channel[chan] is updated by the write, it's only queued if it differs
 		g_eeprom.config.channel_attributes[channel] = p_vfo->channel_attributes;
 
 		memset(&g_eeprom.config.channel_name[channel], 0, sizeof(g_eeprom.config.channel_name[channel]));
@@ -498,6 +659,8 @@ void SETTINGS_save_channel(const unsigned int channel, const unsigned int vfo, v
 		if (mode >= 3 || p_vfo == NULL)
 			SETTINGS_save_chan_name(channel);
 	}
+
+	PROFILE_stop(PROFILE_SETTINGS_SAVE);
 }
 
 void SETTINGS_save_chan_name(const unsigned int channel)
@@ -509,30 +672,37 @@ void SETTINGS_save_chan_name(const unsigned int channel)
 	if (!IS_USER_CHANNEL(channel))
 		return;
 
+	SETTINGS_need_channel(channel);
+
+	PROFILE_start(PROFILE_SETTINGS_SAVE);
 	EEPROM_WriteBuffer8(eeprom_addr + 0, ((uint8_t *)chan_name) + 0);
 	EEPROM_WriteBuffer8(eeprom_addr + 8, ((uint8_t *)chan_name) + 8);
+	PROFILE_stop(PROFILE_SETTINGS_SAVE);
 }
 
 void SETTINGS_save_chan_attribs_name(const unsigned int channel, const vfo_info_t *p_vfo)
 {
-	const unsigned int eeprom_offset = (unsigned int)(((uint8_t *)&g_eeprom.config.channel_attributes) - ((uint8_t *)&g_eeprom));
-	const unsigned int index         = channel & ~7u;     // eeprom writes are always 8 bytes in length
+	const unsigned int index = channel & ~7u;     // eeprom writes are always 8 bytes in length
 
 	if (!IS_USER_CHANNEL(channel) && !IS_FREQ_CHANNEL(channel))
 		return;
 
+	PROFILE_start(PROFILE_SETTINGS_SAVE);
+
 	if (p_vfo != NULL)
 	{	// channel attributes
 		g_eeprom.config.channel_attributes[channel] = p_vfo->channel_attributes;
-		EEPROM_WriteBuffer8(eeprom_offset + index, &g_eeprom.config.channel_attributes[index]);
+		SETTINGS_save_changed(&g_eeprom.config.channel_attributes[index], &saved_attributes[index], 8);
 	}
 	else
 	if (channel <= USER_CHANNEL_LAST)
 	{	// user channel
 		g_eeprom.config.channel_attributes[channel].attributes = 0xff;
-		EEPROM_WriteBuffer8(eeprom_offset + index, &g_eeprom.config.channel_attributes[index]);
+		SETTINGS_save_changed(&g_eeprom.config.channel_attributes[index], &saved_attributes[index], 8);
 	}
 
+	RADIO_update_scan_index(channel);
+
 	if (channel <= USER_CHANNEL_LAST)
 	{	// user memory channel
 		if (p_vfo != NULL)
@@ -546,6 +716,8 @@ void SETTINGS_save_chan_attribs_name(const unsigned int channel, const vfo_info_
 		}
 		SETTINGS_save_chan_name(channel);
 	}
+
+	PROFILE_stop(PROFILE_SETTINGS_SAVE);
 }
 
 unsigned int SETTINGS_find_channel(const uint32_t frequency)
@@ -558,6 +730,8 @@ unsigned int SETTINGS_find_channel(const uint32_t frequency)
 	for (chan = 0; chan <= USER_CHANNEL_LAST; chan++)
 	{
 		const uint32_t freq = g_eeprom.config.channel[chan].frequency;
+		if (deferred_addr < DEFERRED_END && deferred_addr < ((chan + 1) * sizeof(t_channel)))
+			break;  // not loaded yet
 		if (g_eeprom.config.channel_attributes[chan].band > BAND7_470MHz || freq == 0 || freq == 0xffffffff)
 			continue;
 		if (freq == frequency)
@@ -576,6 +750,8 @@ uint32_t SETTINGS_fetch_channel_frequency(const int channel)
 	if (channel < 0 || channel > (int)USER_CHANNEL_LAST)
 		return 0;
 
+	SETTINGS_need_channel(channel);
+
 	freq = g_eeprom.config.channel[channel].frequency;
 
 	if (g_eeprom.config.channel_attributes[channel].band > BAND7_470MHz || freq == 0 || freq == 0xffffffff)
@@ -592,7 +768,10 @@ unsigned int SETTINGS_fetch_channel_step_setting(const int channel)
 		return 0;
 
 	if (channel <= USER_CHANNEL_LAST)
+	{
+		SETTINGS_need_channel(channel);
 		step_setting = g_eeprom.config.channel[channel].step_setting;
+	}
 	else
 	if (channel <= FREQ_CHANNEL_LAST)
 		step_setting = g_eeprom.config.vfo_channel[(channel - FREQ_CHANNEL_FIRST) * 2].step_setting;
@@ -631,6 +810,8 @@ void SETTINGS_fetch_channel_name(char *s, const int channel)
 	if (g_eeprom.config.channel_attributes[channel].band > BAND7_470MHz)
 		return;
 
+	SETTINGS_need_channel(channel);
+
 	memcpy(s, &g_eeprom.config.channel_name[channel], 10);
 
 	for (i = 0; i < 10; i++)
@@ -646,13 +827,14 @@ void SETTINGS_fetch_channel_name(char *s, const int channel)
 void SETTINGS_factory_reset(bool bIsAll)
 {
 	uint16_t i;
-	uint8_t  Template[8];
-
-	memset(Template, 0xFF, sizeof(Template));
+	uint16_t run_start = 0;
+	uint16_t run_size  = 0;
 
-	for (i = 0x0C80; i < 0x1E00; i += 8)
+	// wipe the areas in runs, so they go out to the chip as page writes
+	for (i = 0x0C80; i <= 0x1E00; i += 8)
 	{
 		if (
+			i < 0x1E00 &&
 			!(i >= 0x0EE0 && i < 0x0F18) &&         // ANI ID + DTMF codes
 			!(i >= 0x0F30 && i < 0x0F50) &&         // AES KEY + F LOCK + Scramble Enable
 			!(i >= 0x1C00 && i < 0x1E00) &&         // DTMF contacts
@@ -668,7 +850,15 @@ void SETTINGS_factory_reset(bool bIsAll)
 				))
 			)
 		{
-			EEPROM_WriteBuffer8(i, Template);
+			if (run_size == 0)
+				run_start = i;
+			run_size += 8;
+		}
+		else
+		if (run_size > 0)
+		{
+			EEPROM_fill(run_start, 0xFF, run_size);
+			run_size = 0;
 		}
 	}
 
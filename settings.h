@@ -369,7 +369,8 @@ typedef struct {
 		#ifdef ENABLE_PANADAPTER
 			struct {
 				uint8_t panadapter:1;                   // 1 = enable panadapter
-				uint8_t unused6a:7;                     // 0xff
+				uint8_t panadapter_revisit:2;           // how often the panadapter sweep goes back to the VFO, PAN_REVISIT_*
+				uint8_t unused6a:5;                     // 0xff
 			};
 		#else
 			uint8_t     unused6a;                       // 0xff
@@ -477,7 +478,9 @@ typedef struct {
 				uint8_t unused11g:7;                 // 0xff's
 			};
 
-			uint8_t     unused12[6];                 // 0xff's
+			uint8_t     priority_look_back;          // 100ms units between looks at the priority channels, 0 = off
+
+			uint8_t     unused12[5];                 // 0xff's
 		#endif
 
 	}  __attribute__((packed)) setting;
@@ -486,7 +489,11 @@ typedef struct {
 	t_channel_name channel_name[USER_CHANNEL_LAST - USER_CHANNEL_FIRST + 1];
 
 	// 0x1BD0
-	uint8_t        unused13[16 * 3];      // 0xff's .. free to use
+	#ifdef ENABLE_SCAN_IGNORE_LIST
+		uint32_t   scan_ignore_a[12];     // freq_ignore.c, the first of the ignore list slots
+	#else
+		uint8_t    unused13[16 * 3];      // 0xff's .. free to use
+	#endif
 
 	// 0x1C00
 	struct {
@@ -558,12 +565,28 @@ typedef struct {
 	uint8_t  dac_gain;                              //
 
 	// 0x1F90
-	uint8_t  unused3[16 * 7];                       // 0xff's
+	uint8_t  am_fix_rssi_cal[7];                    // per band AM RSSI correction, 0.5dB units + 128, 0xff = none
+	uint8_t  unused4;                               // 0xff
+	uint8_t  unused3[(16 * 7) - 8];                 // 0xff's
 
 	// 0x2000
 
 } __attribute__((packed)) t_calibration;
 
+#ifdef ENABLE_SCAN_RANGES
+	// one range of a stored frequency scan band plan, lower = 0xffffffff if unused
+	typedef struct {
+		uint32_t lower;               // 10Hz units, first frequency scanned
+		uint16_t steps;               // number of frequencies scanned
+		uint8_t  step_setting;        // STEP_FREQ_TABLE index
+		uint8_t  mod_mode:2;          // FM/AM/DSB
+		uint8_t  bandwidth:2;         // wide/narrow
+		uint8_t  unused:4;            //
+	} __attribute__((packed)) t_scan_range;
+
+	#define SCAN_RANGE_COUNT   16
+#endif
+
 // entire eeprom
 typedef struct {
 
@@ -571,7 +594,20 @@ typedef struct {
 	t_config       config;            // radios user config
 
 	// 0x1D00
-	uint8_t        unused[16 * 16];   // does this belong to the config, or the calibration, or neither ?
+	#ifdef ENABLE_SCAN_RANGES
+		t_scan_range scan_range[SCAN_RANGE_COUNT];   // frequency scan band plan, scanned in the one pass
+	#elif defined(ENABLE_SCAN_IGNORE_LIST)
+		uint32_t     scan_ignore_b[32];              // freq_ignore.c, more ignore list slots
+	#else
+		uint8_t      unused14[16 * 8];               // 0xff's .. free to use
+	#endif
+
+	// 0x1D80
+	#ifdef ENABLE_SCAN_IGNORE_LIST
+		uint32_t     scan_ignore[32];                // freq_ignore.c, the rest of the ignore list slots
+	#else
+		uint8_t      unused[16 * 8];   // does this belong to the config, or the calibration, or neither ?
+	#endif
 
 	// 0x1E00
 	t_calibration  calib;             // calibration settings .. we DO NOT pass this through aircopy, it's radio specific
@@ -622,12 +658,16 @@ typedef struct vfo_info_t
 extern t_eeprom g_eeprom;
 
 void SETTINGS_read_eeprom(void);
+void SETTINGS_load_deferred(void);
+void SETTINGS_load_deferred_all(void);
+void SETTINGS_need_channel(const unsigned int channel);
 void SETTINGS_write_eeprom_config(void);
 
 #ifdef ENABLE_FMRADIO
 	void SETTINGS_save_fm(void);
 #endif
 void SETTINGS_save_vfo_indices(void);
+void SETTINGS_save_attributes(void);
 void SETTINGS_save(void);
 void SETTINGS_save_channel(const unsigned int channel, const unsigned int vfo, vfo_info_t *p_vfo, const unsigned int mode);
 void SETTINGS_save_chan_name(const unsigned int channel);
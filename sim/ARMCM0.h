@@ -0,0 +1,37 @@
+#ifndef SIM_ARMCM0_H
+#define SIM_ARMCM0_H
+
+// stand-in for the CMSIS ARMCM0 device header when building the host simulator
+//
+// only the bits of the Cortex-M0 core the firmware actually touches are
+// provided, SysTick is backed by the simulators virtual clock
+
+#include <stdint.h>
+
+#include "sim/sim.h"
+
+typedef int IRQn_Type;
+
+typedef struct {
+	volatile uint32_t CTRL;
+	volatile uint32_t LOAD;
+	volatile uint32_t VAL;
+	volatile uint32_t CALIB;
+} SysTick_Type;
+
+SysTick_Type *SIM_systick(void);
+
+#define SysTick               (SIM_systick())
+
+uint32_t SysTick_Config(uint32_t ticks);
+
+#define NVIC_EnableIRQ(irq)   ((void)(irq))
+#define NVIC_DisableIRQ(irq)  ((void)(irq))
+#define NVIC_SystemReset()    SIM_exit(0)
+
+#define __NOP()               do {} while (0)
+#define __WFI()               SIM_wait_for_interrupt()
+#define __disable_irq()       do {} while (0)
+#define __enable_irq()        do {} while (0)
+
+#endif
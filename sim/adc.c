@@ -0,0 +1,51 @@
+// SAR ADC stand-in for the host simulator .. a healthy battery and no USB
+
+#include "driver/adc.h"
+
+#define SIM_BATTERY_RAW   2150u   // ~8.0V with the default calibration
+#define SIM_USB_RAW       0u
+
+uint8_t ADC_GetChannelNumber(ADC_CH_MASK Mask)
+{
+	for (unsigned int i = 15; i > 0; i--)
+		if (Mask & (1u << i))
+			return i;
+	return 0U;
+}
+
+void ADC_Disable(void)
+{
+}
+
+void ADC_Enable(void)
+{
+}
+
+void ADC_SoftReset(void)
+{
+}
+
+uint32_t ADC_GetClockConfig(void)
+{
+	return 0;
+}
+
+void ADC_Configure(ADC_Config_t *pAdc)
+{
+	(void)pAdc;
+}
+
+void ADC_Start(void)
+{
+}
+
+bool ADC_CheckEndOfConversion(ADC_CH_MASK Mask)
+{
+	(void)Mask;
+	return true;
+}
+
+uint16_t ADC_GetValue(ADC_CH_MASK Mask)
+{
+	return (Mask == ADC_CH4) ? SIM_BATTERY_RAW : SIM_USB_RAW;
+}
@@ -0,0 +1,261 @@
+// BK4819 register model for the host simulator
+//
+// decodes the 3-wire serial bus the real driver bit-bangs (SCN/SCL/SDA)
+// and keeps a 128 x 16-bit register file behind it
+//
+// the status registers are synthesised .. RSSI/noise/glitch come from a
+// single optional test carrier, and squelch open/close interrupts are
+// raised in REG_02/REG_0C when the tuned frequency moves on/off it
+//
+// with a replayed trace (sim/trace.c) the carrier's levels follow the trace,
+// the RSSI moves with the REG_13 front end gain, and the squelch opens and
+// closes on the REG_4D/4E/4F/78 thresholds the firmware set up
+
+#include <stdlib.h>
+
+#include "driver/bk4819-regs.h"
+#include "driver/gpio.h"
+#include "sim/sim.h"
+
+#define NOISE_FLOOR_RSSI    70u    // (-125dBm + 160) * 2
+#define CARRIER_WIDTH_10Hz  1250u  // +-12.5kHz
+
+static uint16_t regs[128];
+
+static bool     pin_scn = true;
+static bool     pin_scl = true;
+static bool     pin_sda = true;
+
+static bool     active;
+static unsigned int bits;
+static uint32_t shift;
+static bool     reading;
+static uint16_t read_value;
+
+static uint32_t carrier_freq;
+static uint8_t  carrier_rssi;
+
+static bool     squelch_open;
+static uint16_t int_pending;
+
+// REG_13 front end gain steps, dB
+static const int8_t lna_short_dB[4] = {-33, -30, -24,  0};
+static const int8_t lna_dB[8]       = {-24, -19, -14, -9, -6, -4, -2, 0};
+static const int8_t mixer_dB[4]     = { -8,  -6,  -3,  0};
+static const int8_t pga_dB[8]       = {-33, -27, -21, -15, -9, -6, -3, 0};
+
+#define QS_GAIN_REG13       0x03BEu    // the QS default front end gain, -7dB
+
+static int front_end_gain_dB(const uint16_t reg13)
+{
+	return lna_short_dB[(reg13 >> 8) & 3u] + lna_dB[(reg13 >> 5) & 7u] + mixer_dB[(reg13 >> 3) & 3u] + pga_dB[reg13 & 7u];
+}
+
+void SIM_BK4819_set_carrier(const uint32_t freq_10Hz, const uint8_t rssi)
+{
+	carrier_freq = freq_10Hz;
+	carrier_rssi = rssi;
+}
+
+static bool on_carrier(void)
+{
+	const uint32_t freq = ((uint32_t)regs[0x39] << 16) | regs[0x38];
+	return carrier_freq > 0 && (uint32_t)abs((int32_t)(freq - carrier_freq)) <= CARRIER_WIDTH_10Hz;
+}
+
+static void levels(uint16_t *rssi_in, uint16_t *rssi, uint16_t *noise, uint16_t *glitch)
+{	// what the chip measures right now, rssi_in being the RSSI before the front end gain
+	if (!on_carrier())
+	{
+		*rssi_in = NOISE_FLOOR_RSSI;
+		*rssi    = NOISE_FLOOR_RSSI;
+		*noise   = 80;
+		*glitch  = 64;
+		return;
+	}
+
+	if (!SIM_TRACE_active())
+	{
+		*rssi_in = carrier_rssi;
+		*rssi    = carrier_rssi;
+		*noise   = 8;
+		*glitch  = 2;
+		return;
+	}
+
+	SIM_TRACE_levels(rssi_in, noise, glitch);
+
+	if (*rssi_in < NOISE_FLOOR_RSSI)
+	{
+		*rssi_in = NOISE_FLOOR_RSSI;
+		*noise   = 80;
+		*glitch  = 64;
+	}
+
+	{
+		const int r = *rssi_in + ((front_end_gain_dB(regs[0x13]) - front_end_gain_dB(QS_GAIN_REG13)) * 2);
+		*rssi = (r < 0) ? 0 : (r > 0x1FF) ? 0x1FF : r;
+	}
+}
+
+static bool squelch_wanted(void)
+{
+	uint16_t rssi_in;
+	uint16_t rssi;
+	uint16_t noise;
+	uint16_t glitch;
+
+	if (!SIM_TRACE_active())
+		return on_carrier();
+
+	levels(&rssi_in, &rssi, &noise, &glitch);
+
+	if (squelch_open)
+		return rssi >= (regs[0x78] & 0xFFu) && noise <= ((regs[0x4F] >> 8) & 0x7Fu) && glitch <= (regs[0x4D] & 0xFFu);
+
+	return rssi >= (regs[0x78] >> 8) && noise <= (regs[0x4F] & 0x7Fu) && glitch <= (regs[0x4E] & 0xFFu);
+}
+
+static void update_squelch(void)
+{	// the squelch follows the signal whatever the interrupt mask, a change while
+	// it's interrupt is off goes unreported as it would on the chip
+	const bool     open = squelch_wanted();
+	const uint16_t bit  = open ? BK4819_REG_02_SQUELCH_OPENED : BK4819_REG_02_SQUELCH_CLOSED;
+
+	if (open == squelch_open)
+		return;
+
+	squelch_open = open;
+	if (regs[0x3F] & bit)
+		int_pending |= bit;
+
+	SIM_TRACE_squelch(open);
+}
+
+static uint16_t reg_read(const uint8_t reg)
+{
+	g_sim_stats.bk4819_reads++;
+
+	switch (reg)
+	{
+		case 0x0C:	// interrupt request pending + squelch + CxCSS status
+			update_squelch();
+			return ((int_pending != 0) ? 1u : 0u) | (squelch_open ? (1u << 1) : 0u);
+
+		case 0x63:	// glitch
+		case 0x65:	// noise
+		case 0x67:	// RSSI
+		{
+			uint16_t rssi_in;
+			uint16_t rssi;
+			uint16_t noise;
+			uint16_t glitch;
+
+			levels(&rssi_in, &rssi, &noise, &glitch);
+
+			if (reg == 0x63)
+				return glitch;
+			if (reg == 0x65)
+				return noise;
+
+			SIM_TRACE_rssi_read(rssi_in, noise, glitch, rssi, squelch_open);
+			return rssi;
+		}
+
+		default:
+			return regs[reg];
+	}
+}
+
+static void reg_write(const uint8_t reg, const uint16_t value)
+{
+	g_sim_stats.bk4819_writes++;
+
+	switch (reg)
+	{
+		case 0x00:
+			if (value & (1u << 15))
+			{	// soft reset
+				for (unsigned int i = 0; i < 128; i++)
+					regs[i] = 0;
+				squelch_open = false;
+				int_pending  = 0;
+			}
+			return;
+
+		case 0x02:	// latch + clear the pending interrupts
+			regs[0x02]  = int_pending;
+			int_pending = 0;
+			return;
+
+		case 0x13:	// front end gain
+			regs[0x13] = value;
+			SIM_TRACE_gain(value, front_end_gain_dB(value));
+			return;
+
+		default:
+			regs[reg] = value;
+			return;
+	}
+}
+
+void SIM_BK4819_pin_write(const unsigned int pin, const bool level)
+{
+	switch (pin)
+	{
+		case GPIOC_PIN_BK4819_SCN:
+			if (pin_scn && !level)
+			{	// start of transaction
+				active  = true;
+				reading = false;
+				bits    = 0;
+				shift   = 0;
+			}
+			else
+			if (!pin_scn && level)
+			{	// end of transaction
+				if (active && !reading && bits == 24)
+					reg_write((shift >> 16) & 0x7F, shift & 0xFFFF);
+				active = false;
+			}
+			pin_scn = level;
+			break;
+
+		case GPIOC_PIN_BK4819_SCL:
+			if (!pin_scl && level && active)
+			{	// rising clock edge
+				if (reading)
+				{
+					read_value <<= 1;
+				}
+				else
+				{
+					shift = (shift << 1) | (pin_sda ? 1u : 0u);
+					if (++bits == 8 && (shift & 0x80))
+					{
+						reading    = true;
+						read_value = reg_read(shift & 0x7F);
+					}
+				}
+			}
+			pin_scl = level;
+			break;
+
+		case GPIOC_PIN_BK4819_SDA:
+			pin_sda = level;
+			break;
+	}
+}
+
+bool SIM_BK4819_pin_read(const unsigned int pin)
+{
+	if (pin == GPIOC_PIN_BK4819_SDA && active && reading)
+		return (read_value & 0x8000u) != 0;
+
+	switch (pin)
+	{
+		case GPIOC_PIN_BK4819_SCN: return pin_scn;
+		case GPIOC_PIN_BK4819_SCL: return pin_scl;
+		default:                   return pin_sda;
+	}
+}
@@ -0,0 +1,44 @@
+// CRC engine stand-in for the host simulator .. CRC-16/CCITT in software
+
+#include <stdbool.h>
+
+#include "driver/crc.h"
+
+static bool crc_reverse;
+
+void CRC_Init(void)
+{
+	crc_reverse = false;
+}
+
+#ifdef ENABLE_MDC1200
+	void CRC_InitReverse(void)
+	{	// input bit inverted, output bit reversed + inverted
+		crc_reverse = true;
+	}
+#endif
+
+uint16_t CRC_Calculate(const void *buffer, const unsigned int size)
+{
+	const uint8_t *data = (const uint8_t *)buffer;
+	uint16_t       crc  = 0;
+
+	for (unsigned int i = 0; i < size; i++)
+	{
+		const uint8_t byte = crc_reverse ? (uint8_t)~data[i] : data[i];
+
+		crc ^= (uint16_t)byte << 8;
+		for (unsigned int k = 0; k < 8; k++)
+			crc = (crc & 0x8000u) ? (uint16_t)((crc << 1) ^ 0x1021u) : (uint16_t)(crc << 1);
+	}
+
+	if (crc_reverse)
+	{
+		uint16_t rev = 0;
+		for (unsigned int k = 0; k < 16; k++)
+			rev |= ((crc >> k) & 1u) << (15 - k);
+		crc = ~rev;
+	}
+
+	return crc;
+}
@@ -0,0 +1,42 @@
+// GPIO for the host simulator
+//
+// the port registers live in the mapped peripheral window like on the real
+// chip, but any activity on the BK4819's bit-banged serial pins is also fed
+// to the register model so the real driver/bk4819.c can be used unmodified
+
+#include "bsp/dp32g030/gpio.h"
+#include "driver/gpio.h"
+#include "sim/sim.h"
+
+static bool is_bk4819_pin(volatile uint32_t *pReg, const uint8_t Bit)
+{
+	return pReg == &GPIOC->DATA && Bit <= GPIOC_PIN_BK4819_SDA;
+}
+
+void GPIO_ClearBit(volatile uint32_t *pReg, uint8_t Bit)
+{
+	*pReg &= ~(1U << Bit);
+	if (is_bk4819_pin(pReg, Bit))
+		SIM_BK4819_pin_write(Bit, false);
+}
+
+uint8_t GPIO_CheckBit(volatile uint32_t *pReg, uint8_t Bit)
+{
+	if (is_bk4819_pin(pReg, Bit))
+		return SIM_BK4819_pin_read(Bit) ? 1U : 0U;
+	return (*pReg >> Bit) & 1U;
+}
+
+void GPIO_FlipBit(volatile uint32_t *pReg, uint8_t Bit)
+{
+	*pReg ^= 1U << Bit;
+	if (is_bk4819_pin(pReg, Bit))
+		SIM_BK4819_pin_write(Bit, (*pReg >> Bit) & 1U);
+}
+
+void GPIO_SetBit(volatile uint32_t *pReg, uint8_t Bit)
+{
+	*pReg |= 1U << Bit;
+	if (is_bk4819_pin(pReg, Bit))
+		SIM_BK4819_pin_write(Bit, true);
+}
@@ -0,0 +1,213 @@
+// I2C bus + 24C64 EEPROM model for the host simulator
+//
+// sits underneath the real driver/eeprom.c at the byte level, the EEPROM
+// contents are kept in a file so settings survive between runs
+//
+// models the parts of the 24Cxx behaviour the firmware cares about ..
+// 32 byte page write wrap-around, and the internal write cycle during
+// which the chip NACKs its address
+
+#include <stdio.h>
+#include <string.h>
+
+#include "driver/i2c.h"
+#include "sim/sim.h"
+
+#define EEPROM_SIZE          0x2000u
+#define EEPROM_PAGE_SIZE     32u
+#define EEPROM_WRITE_CYCLES  (3u * (SIM_CPU_CLOCK_HZ / 1000u))   // 3ms internal write cycle
+
+// bus time of the bit-banged transfers in driver/i2c.c
+#define I2C_START_CYCLES     (4u * 48u)
+#define I2C_WRITE_CYCLES     (27u * 48u)
+#define I2C_READ_CYCLES      (36u * 48u)
+#define I2C_READ_FAST_CYCLES (18u * 48u)
+
+enum {
+	STATE_IDLE = 0,
+	STATE_CONTROL,
+	STATE_ADDR_HI,
+	STATE_ADDR_LO,
+	STATE_WRITE,
+	STATE_READ
+};
+
+static uint8_t      eeprom[EEPROM_SIZE];
+static FILE        *eeprom_file;
+
+static unsigned int state;
+static uint16_t     address;
+static uint8_t      page[EEPROM_PAGE_SIZE];
+static uint8_t      page_written[EEPROM_PAGE_SIZE];
+static unsigned int page_count;     // bytes clocked in since the address
+static uint64_t     busy_until;
+
+int SIM_EEPROM_open(const char *path, const void *blank_image)
+{
+	memcpy(eeprom, blank_image, sizeof(eeprom));
+
+	eeprom_file = fopen(path, "r+b");
+	if (eeprom_file != NULL)
+	{
+		if (fread(eeprom, 1, sizeof(eeprom), eeprom_file) != sizeof(eeprom))
+			fprintf(stderr, "sim: %s is short, padding with the blank image\n", path);
+		return 0;
+	}
+
+	eeprom_file = fopen(path, "w+b");
+	if (eeprom_file == NULL)
+		return -1;
+
+	fwrite(eeprom, 1, sizeof(eeprom), eeprom_file);
+	fflush(eeprom_file);
+	return 0;
+}
+
+void SIM_EEPROM_close(void)
+{
+	if (eeprom_file != NULL)
+		fclose(eeprom_file);
+	eeprom_file = NULL;
+}
+
+static void commit_page(void)
+{
+	const uint16_t page_base = address & ~(EEPROM_PAGE_SIZE - 1);
+
+	if (page_count == 0)
+		return;
+	if (page_count > EEPROM_PAGE_SIZE)
+		page_count = EEPROM_PAGE_SIZE;
+
+	for (unsigned int i = 0; i < EEPROM_PAGE_SIZE; i++)
+		if (page_written[i])
+			eeprom[page_base + i] = page[i];
+
+	if (eeprom_file != NULL)
+	{
+		fseek(eeprom_file, page_base, SEEK_SET);
+		fwrite(&eeprom[page_base], 1, EEPROM_PAGE_SIZE, eeprom_file);
+		fflush(eeprom_file);
+	}
+
+	g_sim_stats.eeprom_write_bytes += page_count;
+	g_sim_stats.eeprom_write_cycles++;
+
+	busy_until = SIM_cycles() + EEPROM_WRITE_CYCLES;
+	page_count = 0;
+}
+
+void I2C_Start(void)
+{
+	SIM_advance(I2C_START_CYCLES);
+	state = STATE_CONTROL;
+}
+
+void I2C_Stop(void)
+{
+	SIM_advance(I2C_START_CYCLES);
+	if (state == STATE_WRITE)
+		commit_page();
+	state = STATE_IDLE;
+}
+
+static uint8_t read_byte(void)
+{
+	uint8_t data = 0xFF;
+
+	if (state == STATE_READ)
+	{
+		data    = eeprom[address];
+		address = (address + 1) % EEPROM_SIZE;
+		g_sim_stats.eeprom_read_bytes++;
+	}
+
+	return data;
+}
+
+uint8_t I2C_Read_fast(bool bFinal)
+{
+	(void)bFinal;
+	SIM_advance(I2C_READ_FAST_CYCLES);
+	return read_byte();
+}
+
+uint8_t I2C_Read(bool bFinal)
+{
+	(void)bFinal;
+	SIM_advance(I2C_READ_CYCLES);
+	return read_byte();
+}
+
+int I2C_Write(uint8_t Data)
+{
+	SIM_advance(I2C_WRITE_CYCLES);
+
+	switch (state)
+	{
+		case STATE_CONTROL:
+			if ((Data & 0xFE) != 0xA0 || SIM_cycles() < busy_until)
+			{	// not us, or still busy burning the last page in
+				state = STATE_IDLE;
+				return -1;
+			}
+			state = (Data & 1u) ? STATE_READ : STATE_ADDR_HI;
+			return 0;
+
+		case STATE_ADDR_HI:
+			address = (uint16_t)(Data << 8) % EEPROM_SIZE;
+			state   = STATE_ADDR_LO;
+			return 0;
+
+		case STATE_ADDR_LO:
+			address |= Data;
+			state      = STATE_WRITE;
+			page_count = 0;
+			memset(page_written, 0, sizeof(page_written));
+			return 0;
+
+		case STATE_WRITE:
+		{	// the address counter wraps within the current page
+			const unsigned int offset = (address + page_count) % EEPROM_PAGE_SIZE;
+			page[offset]         = Data;
+			page_written[offset] = 1;
+			page_count++;
+			return 0;
+		}
+
+		default:
+			return -1;
+	}
+}
+
+bool I2C_probe(const uint8_t Address)
+{
+	int ret;
+
+	I2C_Start();
+	ret = I2C_Write(Address);
+	I2C_Stop();
+
+	return ret == 0;
+}
+
+int I2C_ReadBuffer(void *pBuffer, const unsigned int Size, const bool fast)
+{
+	uint8_t *pData = (uint8_t *)pBuffer;
+
+	for (unsigned int i = 0; i < Size; i++)
+		pData[i] = fast ? I2C_Read_fast(i == (Size - 1)) : I2C_Read(i == (Size - 1));
+
+	return Size;
+}
+
+int I2C_WriteBuffer(const void *pBuffer, const unsigned int Size)
+{
+	const uint8_t *pData = (const uint8_t *)pBuffer;
+
+	for (unsigned int i = 0; i < Size; i++)
+		if (I2C_Write(*pData++) < 0)
+			return -1;
+
+	return 0;
+}
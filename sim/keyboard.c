@@ -0,0 +1,131 @@
+// keypad stand-in for the host simulator
+//
+// key presses come from a script given on the command line ..
+//
+//    <time ms>:<key>[:<hold ms>],...
+//
+// keys are 0-9, M(enu), U(p), D(own), E(xit), *, F, P(TT), S1, S2 (side keys)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bsp/dp32g030/gpio.h"
+#include "driver/gpio.h"
+#include "driver/i2c.h"
+#include "driver/keyboard.h"
+#include "driver/systick.h"
+#include "misc.h"
+#include "sim/sim.h"
+
+int8_t     g_ptt_debounce;
+uint8_t    g_key_debounce_press;
+uint8_t    g_key_debounce_repeat;
+key_code_t g_key_prev    = KEY_INVALID;
+key_code_t g_key_pressed = KEY_INVALID;
+bool       g_key_held;
+bool       g_fkey_pressed;
+bool       g_ptt_is_pressed;
+
+bool       g_ptt_was_released;
+bool       g_ptt_was_pressed;
+uint8_t    g_keypad_locked;
+
+#define SCRIPT_MAX_KEYS  64
+
+static struct {
+	uint32_t   start_ms;
+	uint32_t   hold_ms;
+	key_code_t key;
+} script[SCRIPT_MAX_KEYS];
+
+static unsigned int script_len;
+
+static key_code_t key_from_name(const char *name)
+{
+	static const struct {
+		const char *name;
+		key_code_t  key;
+	} names[] = {
+		{"M",  KEY_MENU},
+		{"U",  KEY_UP},
+		{"D",  KEY_DOWN},
+		{"E",  KEY_EXIT},
+		{"*",  KEY_STAR},
+		{"F",  KEY_F},
+		{"P",  KEY_PTT},
+		{"S1", KEY_SIDE1},
+		{"S2", KEY_SIDE2}
+	};
+
+	if (name[0] >= '0' && name[0] <= '9' && name[1] == 0)
+		return (key_code_t)(KEY_0 + (name[0] - '0'));
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(names); i++)
+		if (strcmp(name, names[i].name) == 0)
+			return names[i].key;
+
+	return KEY_INVALID;
+}
+
+int SIM_KEYBOARD_script(const char *text)
+{
+	char buf[512];
+	char *save = NULL;
+
+	snprintf(buf, sizeof(buf), "%s", text);
+
+	for (char *tok = strtok_r(buf, ",", &save); tok != NULL; tok = strtok_r(NULL, ",", &save))
+	{
+		char  name[4];
+		unsigned int start_ms;
+		unsigned int hold_ms = 100;
+
+		if (script_len >= ARRAY_SIZE(script))
+			return -1;
+
+		if (sscanf(tok, "%u:%3[^:]:%u", &start_ms, name, &hold_ms) < 2)
+			return -1;
+
+		script[script_len].start_ms = start_ms;
+		script[script_len].hold_ms  = hold_ms;
+		script[script_len].key      = key_from_name(name);
+		if (script[script_len].key == KEY_INVALID)
+			return -1;
+		script_len++;
+	}
+
+	return 0;
+}
+
+key_code_t KEYBOARD_Poll(void)
+{
+	const uint32_t now_ms = SIM_cycles() / (SIM_CPU_CLOCK_HZ / 1000u);
+	key_code_t     Key    = KEY_INVALID;
+	bool           ptt    = false;
+
+	// the real scan takes ~60us
+	SYSTICK_Delay250ns(240);
+
+	for (unsigned int i = 0; i < script_len; i++)
+	{
+		if (now_ms < script[i].start_ms || now_ms >= (script[i].start_ms + script[i].hold_ms))
+			continue;
+		if (script[i].key == KEY_PTT)
+			ptt = true;
+		else
+			Key = script[i].key;
+	}
+
+	// PTT has it's own pin (active low)
+	if (ptt)
+		GPIOC->DATA &= ~(1u << GPIOC_PIN_PTT);
+	else
+		GPIOC->DATA |=   1u << GPIOC_PIN_PTT;
+
+	I2C_Stop();
+
+	g_key_pressed = Key;
+
+	return Key;
+}
@@ -0,0 +1,243 @@
+// host-native simulator entry point
+//
+// maps the DP32G030 peripheral window at its real address so the firmware's
+// register accesses land in ordinary memory, sets up the stand-in drivers,
+// then hands over to the firmware's own Main()
+//
+//   ./firmware.sim [-t <run ms>] [-e <eeprom file>] [-d <frame dump dir>]
+//                  [-k <key script>] [-c <carrier Hz>[:<rssi>]]
+//                  [-r <rssi trace file>] [-l <trace log file>]
+
+#define _GNU_SOURCE
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bsp/dp32g030/gpio.h"
+#include "driver/gpio.h"
+#include "frequencies.h"
+#include "helper/boot.h"
+#include "misc.h"
+#include "profile.h"
+#include "settings.h"
+#include "sim/sim.h"
+
+#define PERIPH_BASE  0x40000000u
+#define PERIPH_SIZE  0x000C0000u
+
+void Main(void);
+
+sim_stats_t g_sim_stats;
+
+static struct timespec host_start;
+
+static double host_seconds(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - host_start.tv_sec) + (now.tv_nsec - host_start.tv_nsec) / 1e9;
+}
+
+void SIM_exit(int code)
+{
+	const double virt_s = (double)SIM_cycles() / SIM_CPU_CLOCK_HZ;
+	const double host_s = host_seconds();
+
+	fprintf(stderr,
+		"\nsim: %.3f s virtual, %.3f s host (x%.1f)\n"
+		"sim: systicks %llu\n"
+		"sim: bk4819  reads %llu  writes %llu\n"
+		"sim: eeprom  read %llu B  write %llu B in %llu cycles\n"
+		"sim: lcd     blits %llu  bytes %llu\n",
+		virt_s, host_s, (host_s > 0) ? virt_s / host_s : 0.0,
+		(unsigned long long)g_sim_stats.systicks,
+		(unsigned long long)g_sim_stats.bk4819_reads,
+		(unsigned long long)g_sim_stats.bk4819_writes,
+		(unsigned long long)g_sim_stats.eeprom_read_bytes,
+		(unsigned long long)g_sim_stats.eeprom_write_bytes,
+		(unsigned long long)g_sim_stats.eeprom_write_cycles,
+		(unsigned long long)g_sim_stats.lcd_blits,
+		(unsigned long long)g_sim_stats.lcd_bytes);
+
+	{
+		static const char *names[BOOT_PHASE_COUNT] = {"drivers", "settings", "bk4819", "radio", "menu", "splash", "main loop", "eeprom"};
+		fprintf(stderr, "sim: boot us ");
+		for (unsigned int i = 0; i < BOOT_PHASE_COUNT; i++)
+			fprintf(stderr, " %s %u", names[i], g_boot_time_us[i]);
+		fprintf(stderr, "\n");
+	}
+
+	#ifdef ENABLE_PROFILER
+	{
+		static const char *names[PROFILE_SECTION_COUNT] = {"slice 10ms", "slice 500ms", "display", "radio irq", "settings save"};
+		fprintf(stderr, "sim: profile overruns %u  missed ticks %u\n", g_profile_overruns, g_profile_missed_ticks);
+		for (unsigned int i = 0; i < PROFILE_SECTION_COUNT; i++)
+		{
+			const profile_stats_t *p = &g_profile[i];
+			fprintf(stderr, "sim: %-13s n %6u  min %7u  avg %7u  max %7u  |",
+				names[i], p->count, (p->count > 0) ? p->min_cycles : 0,
+				(p->count > 0) ? (unsigned int)(p->total_cycles / p->count) : 0, p->max_cycles);
+			for (unsigned int b = 0; b < PROFILE_HIST_BUCKETS; b++)
+				fprintf(stderr, " %u", p->hist[b]);
+			fprintf(stderr, "\n");
+		}
+	}
+	#endif
+
+	SIM_TRACE_report();
+
+	SIM_EEPROM_close();
+	exit(code);
+}
+
+static void make_blank_eeprom(t_eeprom *image)
+{	// what a newly programmed radio looks like, the firmware trusts the
+	// EEPROM contents so an all 0xFF part isn't something it can boot from
+
+	static const uint16_t battery_calib[6] = {1900, 2000, 2020, 2050, 2080, 2300};
+	t_config             *config           = &image->config;
+
+	memset(image, 0xFF, sizeof(*image));
+
+	// both VFO's of every band on the band's lower edge (433.5MHz for UHF), 12.5kHz steps
+	for (unsigned int band = 0; band < ARRAY_SIZE(FREQ_BAND_TABLE); band++)
+	{
+		for (unsigned int vfo = 0; vfo < 2; vfo++)
+		{
+			t_channel *chan = &config->vfo_channel[(band * 2) + vfo];
+			memset(chan, 0, sizeof(*chan));
+			chan->frequency    = (band == BAND6_400MHz) ? 43350000 : FREQ_BAND_TABLE[band].lower;
+			chan->step_setting = 4;
+		}
+		config->channel_attributes[FREQ_CHANNEL_FIRST + band].attributes = 0xC0 | band;
+	}
+	config->channel_attributes[ARRAY_SIZE(config->channel_attributes) - 1].attributes = 0x00;
+
+	memset(&config->setting.call1, 0, offsetof(typeof(config->setting), aes_key) - offsetof(typeof(config->setting), call1));
+	config->setting.squelch_level         = 1;
+	config->setting.tx_timeout            = 1;
+	config->setting.mic_sensitivity       = 4;
+	config->setting.backlight_time        = 3;
+	config->setting.power_on_display_mode = PWR_ON_DISPLAY_MODE_NONE;
+	config->setting.scan_hold_time        = 6;
+	config->setting.tx_enable             = 1;
+	for (unsigned int vfo = 0; vfo < 2; vfo++)
+	{
+		config->setting.indices.vfo[vfo].screen    = FREQ_CHANNEL_FIRST + BAND6_400MHz;
+		config->setting.indices.vfo[vfo].frequency = FREQ_CHANNEL_FIRST + BAND6_400MHz;
+		config->setting.indices.vfo[vfo].user      = USER_CHANNEL_FIRST;
+	}
+
+	memcpy(image->calib.battery, battery_calib, sizeof(battery_calib));
+}
+
+static void usage(const char *name)
+{
+	fprintf(stderr,
+		"usage: %s [-t <run ms>] [-e <eeprom file>] [-d <frame dump dir>] [-k <key script>] [-c <carrier Hz>[:<rssi>]] [-r <rssi trace file>] [-l <trace log file>]\n"
+		"   -t  virtual time to run for (default 10000ms, 0 = forever)\n"
+		"   -e  file backing the 8kB EEPROM (default sim_eeprom.bin)\n"
+		"   -d  dump every changed LCD frame as a PBM into this directory\n"
+		"   -k  key presses, <ms>:<key>[:<hold ms>],... keys 0-9 M U D E * F P S1 S2\n"
+		"   -c  put a test carrier on this frequency (default rssi 200 = -60dBm)\n"
+		"   -r  replay the carrier's rssi/noise/glitch from this file (sim/trace.c), needs -c\n"
+		"   -l  log every RSSI read during the trace replay to this CSV file\n",
+		name);
+}
+
+int main(int argc, char *argv[])
+{
+	const char  *eeprom_path = "sim_eeprom.bin";
+	unsigned int run_ms      = 10000;
+	bool         carrier     = false;
+	int          opt;
+
+	while ((opt = getopt(argc, argv, "t:e:d:k:c:r:l:h")) != -1)
+	{
+		switch (opt)
+		{
+			case 't':
+				run_ms = strtoul(optarg, NULL, 0);
+				break;
+			case 'e':
+				eeprom_path = optarg;
+				break;
+			case 'd':
+				SIM_ST7565_set_dump_dir(optarg);
+				break;
+			case 'k':
+				if (SIM_KEYBOARD_script(optarg) < 0)
+				{
+					fprintf(stderr, "sim: bad key script '%s'\n", optarg);
+					return 1;
+				}
+				break;
+			case 'c':
+			{
+				unsigned long freq = 0;
+				unsigned int  rssi = 200;
+				sscanf(optarg, "%lu:%u", &freq, &rssi);
+				SIM_BK4819_set_carrier(freq / 10, rssi);
+				carrier = freq > 0;
+				break;
+			}
+			case 'r':
+				if (SIM_TRACE_load(optarg) < 0)
+				{
+					fprintf(stderr, "sim: bad rssi trace '%s'\n", optarg);
+					return 1;
+				}
+				break;
+			case 'l':
+				if (SIM_TRACE_log(optarg) < 0)
+				{
+					perror(optarg);
+					return 1;
+				}
+				break;
+			default:
+				usage(argv[0]);
+				return 1;
+		}
+	}
+
+	if (SIM_TRACE_active() && !carrier)
+	{
+		fprintf(stderr, "sim: -r needs a carrier frequency (-c) to replay the trace on\n");
+		return 1;
+	}
+
+	if (mmap((void *)(uintptr_t)PERIPH_BASE, PERIPH_SIZE, PROT_READ | PROT_WRITE,
+	         MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0) != (void *)(uintptr_t)PERIPH_BASE)
+	{
+		perror("sim: can't map the peripheral window");
+		return 1;
+	}
+
+	{
+		static t_eeprom blank_image;
+		make_blank_eeprom(&blank_image);
+		if (SIM_EEPROM_open(eeprom_path, &blank_image) < 0)
+		{
+			perror(eeprom_path);
+			return 1;
+		}
+	}
+
+	// pulled-up inputs .. PTT and the keypad read high when nothing is pressed
+	GPIOA->DATA = 0xFFFF;
+	GPIOC->DATA = 1u << GPIOC_PIN_PTT;
+
+	SIM_set_run_time_ms(run_ms);
+
+	clock_gettime(CLOCK_MONOTONIC, &host_start);
+
+	Main();
+
+	SIM_exit(0);
+}
@@ -0,0 +1,59 @@
+#ifndef SIM_SIM_H
+#define SIM_SIM_H
+
+// host-native simulator .. shared between the stand-in drivers in sim/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SIM_CPU_CLOCK_HZ    48000000u
+#define SIM_TICK_CYCLES     (SIM_CPU_CLOCK_HZ / 100u)   // 10ms SysTick period
+
+typedef struct {
+	uint64_t systicks;              // 10ms SysTick interrupts taken
+	uint64_t bk4819_reads;          // BK4819 register reads
+	uint64_t bk4819_writes;         // BK4819 register writes
+	uint64_t eeprom_read_bytes;
+	uint64_t eeprom_write_bytes;
+	uint64_t eeprom_write_cycles;   // internal 24Cxx program cycles
+	uint64_t lcd_blits;             // full screen + status line blits
+	uint64_t lcd_bytes;             // display data bytes pushed to the ST7565
+} sim_stats_t;
+
+extern sim_stats_t g_sim_stats;
+
+// virtual time (sim/systick.c)
+uint64_t SIM_cycles(void);
+void     SIM_advance(uint64_t cycles);
+void     SIM_wait_for_interrupt(void);
+void     SIM_set_run_time_ms(uint32_t ms);
+
+// sim/main.c
+void     SIM_exit(int code) __attribute__((noreturn));
+
+// BK4819 register model (sim/bk4819.c)
+void     SIM_BK4819_pin_write(unsigned int pin, bool level);
+bool     SIM_BK4819_pin_read(unsigned int pin);
+void     SIM_BK4819_set_carrier(uint32_t freq_10Hz, uint8_t rssi);
+
+// replayed RSSI trace (sim/trace.c)
+int      SIM_TRACE_load(const char *path);
+int      SIM_TRACE_log(const char *path);
+bool     SIM_TRACE_active(void);
+void     SIM_TRACE_levels(uint16_t *rssi, uint16_t *noise, uint16_t *glitch);
+void     SIM_TRACE_gain(uint16_t reg13, int gain_dB);
+void     SIM_TRACE_squelch(bool open);
+void     SIM_TRACE_rssi_read(uint16_t rssi_in, uint16_t noise, uint16_t glitch, uint16_t rssi_out, bool squelch_open);
+void     SIM_TRACE_report(void);
+
+// file backed 24C64 (sim/i2c.c)
+int      SIM_EEPROM_open(const char *path, const void *blank_image);
+void     SIM_EEPROM_close(void);
+
+// ST7565 frame dumper (sim/st7565.c)
+void     SIM_ST7565_set_dump_dir(const char *path);
+
+// scripted key presses (sim/keyboard.c)
+int      SIM_KEYBOARD_script(const char *script);
+
+#endif
@@ -0,0 +1,159 @@
+// ST7565 LCD stand-in for the host simulator
+//
+// keeps a copy of the display RAM, counts what would have gone over SPI,
+// and optionally dumps every changed frame as a 128x64 PBM image
+//
+// blits follow the real driver, only the bytes that differ from the display
+// RAM are counted as sent
+
+#include <stdio.h>
+#include <string.h>
+
+#include "driver/st7565.h"
+#include "misc.h"
+#include "sim/sim.h"
+
+uint8_t g_status_line[128];
+uint8_t g_frame_buffer[7][128];
+
+#ifdef ENABLE_CONTRAST
+	uint8_t contrast = 31;  // 0 ~ 63
+#endif
+
+// 8 pages of 128 columns, page 0 is the status line
+static uint8_t      lcd_ram[8][LCD_WIDTH];
+static uint8_t      lcd_dumped[8][LCD_WIDTH];
+static const char  *dump_dir;
+static unsigned int dump_count;
+
+// SPI0 at 4MHz .. 2us per byte
+#define LCD_BYTE_CYCLES  (2u * 48u)
+
+void SIM_ST7565_set_dump_dir(const char *path)
+{
+	dump_dir = path;
+}
+
+static void dump_frame(void)
+{
+	char  name[256];
+	FILE *fp;
+
+	if (dump_dir == NULL || memcmp(lcd_ram, lcd_dumped, sizeof(lcd_ram)) == 0)
+		return;
+	memcpy(lcd_dumped, lcd_ram, sizeof(lcd_ram));
+
+	snprintf(name, sizeof(name), "%s/frame_%06u_%08llums.pbm",
+		dump_dir, dump_count++, (unsigned long long)(SIM_cycles() / (SIM_CPU_CLOCK_HZ / 1000u)));
+
+	fp = fopen(name, "wb");
+	if (fp == NULL)
+		return;
+
+	fprintf(fp, "P1\n%u %u\n", LCD_WIDTH, LCD_HEIGHT);
+	for (unsigned int y = 0; y < LCD_HEIGHT; y++)
+	{
+		for (unsigned int x = 0; x < LCD_WIDTH; x++)
+			fputc(((lcd_ram[y / 8][x] >> (y % 8)) & 1u) ? '1' : '0', fp);
+		fputc('\n', fp);
+	}
+
+	fclose(fp);
+}
+
+static void write_page(const unsigned int page, const unsigned int column, const unsigned int size, const uint8_t *data)
+{
+	for (unsigned int i = 0; i < size && (column + i) < LCD_WIDTH; i++)
+		lcd_ram[page][column + i] = (data != NULL) ? data[i] : 0;
+
+	g_sim_stats.lcd_bytes += size;
+	SIM_advance((uint64_t)size * LCD_BYTE_CYCLES);
+}
+
+static void send_changes(const unsigned int page, const uint8_t *data, unsigned int column, const unsigned int last, const bool all)
+{	// each run of changed bytes costs it's bytes + a 3 byte column/line address
+	while (column <= last)
+	{
+		unsigned int end;
+
+		while (column <= last && !all && data[column] == lcd_ram[page][column])
+			column++;
+		if (column > last)
+			break;
+
+		for (end = column; end <= last && (all || data[end] != lcd_ram[page][end]); end++) {}
+
+		write_page(page, column, end - column, &data[column]);
+		g_sim_stats.lcd_bytes += 3;
+		column = end;
+	}
+}
+
+void ST7565_DrawLine(const unsigned int Column, const unsigned int Line, const unsigned int Size, const uint8_t *pBitmap)
+{
+	if (Line < 8)
+		write_page(Line, Column, Size, pBitmap);
+	dump_frame();
+}
+
+void ST7565_BlitFullScreen(void)
+{
+	for (unsigned int Line = 0; Line < ARRAY_SIZE(g_frame_buffer); Line++)
+		send_changes(Line + 1, g_frame_buffer[Line], 0, LCD_WIDTH - 1, false);
+
+	g_sim_stats.lcd_blits++;
+	dump_frame();
+}
+
+void ST7565_BlitStatusLine(void)
+{
+	send_changes(0, g_status_line, 0, LCD_WIDTH - 1, false);
+
+	g_sim_stats.lcd_blits++;
+	dump_frame();
+}
+
+void ST7565_refresh(void)
+{
+	send_changes(0, g_status_line, 0, LCD_WIDTH - 1, true);
+	for (unsigned int Line = 0; Line < ARRAY_SIZE(g_frame_buffer); Line++)
+		send_changes(Line + 1, g_frame_buffer[Line], 0, LCD_WIDTH - 1, true);
+
+	g_sim_stats.lcd_blits++;
+	dump_frame();
+}
+
+void ST7565_FillScreen(const uint8_t Value)
+{
+	memset(lcd_ram, Value, sizeof(lcd_ram));
+	g_sim_stats.lcd_bytes += 8 * 132;
+	dump_frame();
+}
+
+void ST7565_Init(const bool full)
+{
+	if (full)
+		ST7565_FillScreen(0x00);
+}
+
+void ST7565_HardwareReset(void)
+{
+}
+
+void ST7565_SelectColumnAndLine(const uint8_t Column, const uint8_t Line)
+{
+	(void)Column;
+	(void)Line;
+}
+
+#ifdef ENABLE_CONTRAST
+	void ST7565_SetContrast(const uint8_t value)
+	{
+		contrast = (value > 45) ? 45 : (value < 26) ? 26 : value;
+	}
+
+	uint8_t ST7565_GetContrast(void)
+	{
+		return contrast;
+	}
+#endif
@@ -0,0 +1,81 @@
+// virtual SysTick for the host simulator
+//
+// time only moves forward when the firmware delays or sleeps (WFI), every
+// 10ms boundary crossed runs the firmwares SystickHandler() just as the
+// real interrupt would
+
+#include "ARMCM0.h"
+#include "driver/systick.h"
+#include "sim/sim.h"
+
+void SystickHandler(void);
+
+static uint64_t     sim_cycles;         // 48MHz cycles since power on
+static uint64_t     sim_end_cycles;     // 0 = run forever
+static SysTick_Type sim_systick;
+
+uint64_t SIM_cycles(void)
+{
+	return sim_cycles;
+}
+
+void SIM_set_run_time_ms(const uint32_t ms)
+{
+	sim_end_cycles = (uint64_t)ms * (SIM_CPU_CLOCK_HZ / 1000u);
+}
+
+void SIM_advance(uint64_t cycles)
+{
+	while (cycles > 0)
+	{
+		const uint64_t to_tick = SIM_TICK_CYCLES - (sim_cycles % SIM_TICK_CYCLES);
+
+		if (cycles < to_tick)
+		{
+			sim_cycles += cycles;
+			break;
+		}
+
+		sim_cycles += to_tick;
+		cycles     -= to_tick;
+
+		if (sim_end_cycles > 0 && sim_cycles >= sim_end_cycles)
+			SIM_exit(0);
+
+		g_sim_stats.systicks++;
+		SystickHandler();
+	}
+}
+
+void SIM_wait_for_interrupt(void)
+{	// sleep till the next SysTick
+	SIM_advance(SIM_TICK_CYCLES - (sim_cycles % SIM_TICK_CYCLES));
+}
+
+SysTick_Type *SIM_systick(void)
+{
+	sim_systick.LOAD = SIM_TICK_CYCLES - 1;
+	sim_systick.VAL  = (SIM_TICK_CYCLES - 1) - (uint32_t)(sim_cycles % SIM_TICK_CYCLES);   // down counter
+	return &sim_systick;
+}
+
+uint32_t SysTick_Config(uint32_t ticks)
+{
+	(void)ticks;
+	return 0;
+}
+
+void SYSTICK_Init(void)
+{
+	SysTick_Config(SIM_TICK_CYCLES);
+}
+
+void SYSTICK_Delay250ns(const uint32_t Delay)
+{
+	SIM_advance(((uint64_t)Delay * (SIM_CPU_CLOCK_HZ / 1000000u)) >> 2);
+}
+
+uint32_t SYSTICK_get_cycles(void)
+{
+	return (uint32_t)sim_cycles;
+}
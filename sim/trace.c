@@ -0,0 +1,276 @@
+// replayed RSSI trace for the host simulator
+//
+// feeds a recorded or made up sequence of carrier levels to the BK4819 model
+// in place of the fixed -c level, so the AM fix gain control and the squelch
+// can be checked against the same signal every time
+//
+// trace file, one step per line, '#' starts a comment
+//
+//   <ms> <rssi> [<noise> [<glitch>]]
+//
+// each level holds from <ms> until the next line's, RSSI is in the chip's own
+// units ((dBm + 160) * 2) as it would read with the front end at the QS default
+// gain .. the BK4819 model takes the REG_13 gain off it before the firmware sees it
+//
+// every step is a segment in the report printed when the run ends
+//
+//   changes   REG_13 gain writes that changed the gain
+//   settle    time from the step to the last gain change
+//   gain      front end gain the segment ended with
+//   overshoot how far the gain went past where it ended up
+//   diff      the firmware's rssi_gain_diff[] at the end of the segment
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef ENABLE_AM_FIX
+	#include "am_fix.h"
+#endif
+#include "sim/sim.h"
+
+#define TRACE_MAX_STEPS  1024
+
+typedef struct {
+	uint32_t ms;
+	uint16_t rssi;
+	uint16_t noise;
+	uint16_t glitch;
+} trace_step_t;
+
+typedef struct {
+	int      start_gain_dB;
+	int      min_gain_dB;
+	int      max_gain_dB;
+	int      gain_dB;
+	uint16_t reg13;
+	uint32_t changes;
+	uint32_t last_change_ms;
+	uint32_t squelch_opens;
+	uint32_t squelch_closes;
+	int16_t  gain_diff[2];
+} trace_seg_t;
+
+static trace_step_t steps[TRACE_MAX_STEPS];
+static trace_seg_t  segs[TRACE_MAX_STEPS];
+static unsigned int step_count;
+static unsigned int seg;            // segment the stats are going into
+static int          gain_dB;        // front end gain as last written
+static uint16_t     reg13 = 0xFFFF; // nothing written yet
+static FILE        *log_fp;
+
+static int seg_overshoot(const trace_seg_t *s)
+{	// past the final gain in the direction it was heading, either way if it ended where it started
+	const int below = s->gain_dB - s->min_gain_dB;
+	const int above = s->max_gain_dB - s->gain_dB;
+
+	if (s->gain_dB < s->start_gain_dB)
+		return below;
+	if (s->gain_dB > s->start_gain_dB)
+		return above;
+	return (above > below) ? above : below;
+}
+
+static uint32_t now_ms(void)
+{
+	return (uint32_t)(SIM_cycles() / (SIM_CPU_CLOCK_HZ / 1000u));
+}
+
+static void seg_open(const unsigned int index)
+{
+	trace_seg_t *s = &segs[index];
+
+	s->start_gain_dB = gain_dB;
+	s->min_gain_dB   = gain_dB;
+	s->max_gain_dB   = gain_dB;
+	s->gain_dB       = gain_dB;
+	s->reg13         = reg13;
+}
+
+static void seg_close(const unsigned int index)
+{
+	#ifdef ENABLE_AM_FIX
+		segs[index].gain_diff[0] = rssi_gain_diff[0];
+		segs[index].gain_diff[1] = rssi_gain_diff[1];
+	#else
+		(void)index;
+	#endif
+}
+
+static void seg_update(void)
+{	// move the stats on to whichever step we're in now
+	const uint32_t ms = now_ms();
+
+	while (seg + 1 < step_count && ms >= steps[seg + 1].ms)
+	{
+		seg_close(seg);
+		seg_open(++seg);
+	}
+}
+
+int SIM_TRACE_load(const char *path)
+{
+	char  line[128];
+	FILE *fp = fopen(path, "r");
+
+	if (fp == NULL)
+		return -1;
+
+	step_count = 0;
+
+	while (fgets(line, sizeof(line), fp) != NULL)
+	{
+		unsigned long ms;
+		unsigned int  rssi;
+		unsigned int  noise  = 8;
+		unsigned int  glitch = 2;
+		char         *hash   = strchr(line, '#');
+
+		if (hash != NULL)
+			*hash = 0;
+
+		if (sscanf(line, "%lu %u %u %u", &ms, &rssi, &noise, &glitch) < 2)
+			continue;    // blank
+
+		if (step_count >= TRACE_MAX_STEPS || (step_count > 0 && ms <= steps[step_count - 1].ms))
+		{
+			fclose(fp);
+			return -1;
+		}
+
+		steps[step_count].ms     = ms;
+		steps[step_count].rssi   = (rssi   > 0x1FF) ? 0x1FF : rssi;
+		steps[step_count].noise  = (noise  > 0x7F)  ? 0x7F  : noise;
+		steps[step_count].glitch = (glitch > 0xFF)  ? 0xFF  : glitch;
+		step_count++;
+	}
+
+	fclose(fp);
+
+	if (step_count == 0 || (steps[0].ms > 0 && step_count >= TRACE_MAX_STEPS))
+		return -1;
+
+	if (steps[0].ms > 0)
+	{	// nothing on air before the first step
+		memmove(&steps[1], &steps[0], step_count * sizeof(steps[0]));
+		steps[0] = (trace_step_t){0, 0, 0x7F, 0xFF};
+		step_count++;
+	}
+
+	seg_open(0);
+	return 0;
+}
+
+int SIM_TRACE_log(const char *path)
+{
+	log_fp = fopen(path, "w");
+	if (log_fp == NULL)
+		return -1;
+
+	fprintf(log_fp, "ms,rssi_in,noise,glitch,reg13,gain_dB,rssi_out,squelch\n");
+	return 0;
+}
+
+bool SIM_TRACE_active(void)
+{
+	return step_count > 0;
+}
+
+void SIM_TRACE_levels(uint16_t *rssi, uint16_t *noise, uint16_t *glitch)
+{
+	const uint32_t ms = now_ms();
+	unsigned int   i  = seg;
+
+	while (i + 1 < step_count && ms >= steps[i + 1].ms)
+		i++;
+
+	*rssi   = steps[i].rssi;
+	*noise  = steps[i].noise;
+	*glitch = steps[i].glitch;
+}
+
+void SIM_TRACE_gain(const uint16_t reg, const int dB)
+{
+	trace_seg_t *s;
+
+	if (step_count == 0 || reg == reg13)
+		return;
+
+	if (reg13 == 0xFFFF)
+	{	// the firmware's initial setting, not a change
+		gain_dB = dB;
+		reg13   = reg;
+		seg_open(seg);
+		return;
+	}
+
+	seg_update();
+
+	s = &segs[seg];
+
+	if (dB != gain_dB)
+	{
+		s->changes++;
+		s->last_change_ms = now_ms();
+		s->min_gain_dB    = (dB < s->min_gain_dB) ? dB : s->min_gain_dB;
+		s->max_gain_dB    = (dB > s->max_gain_dB) ? dB : s->max_gain_dB;
+	}
+
+	s->gain_dB = dB;
+	s->reg13   = reg;
+	gain_dB    = dB;
+	reg13      = reg;
+}
+
+void SIM_TRACE_squelch(const bool open)
+{
+	if (step_count == 0)
+		return;
+
+	seg_update();
+
+	if (open)
+		segs[seg].squelch_opens++;
+	else
+		segs[seg].squelch_closes++;
+}
+
+void SIM_TRACE_rssi_read(const uint16_t rssi_in, const uint16_t noise, const uint16_t glitch, const uint16_t rssi_out, const bool squelch_open)
+{
+	if (log_fp != NULL)
+		fprintf(log_fp, "%u,%u,%u,%u,0x%04X,%d,%u,%u\n", now_ms(), rssi_in, noise, glitch, reg13, gain_dB, rssi_out, squelch_open ? 1u : 0u);
+}
+
+void SIM_TRACE_report(void)
+{
+	if (step_count == 0)
+		return;
+
+	seg_update();
+	seg_close(seg);
+
+	fprintf(stderr, "sim: trace       ms  rssi changes settle ms    reg13 gain dB overshoot dB  diff0  diff1  sq open/close\n");
+
+	for (unsigned int i = 0; i <= seg; i++)
+	{
+		const trace_seg_t *s = &segs[i];
+
+		fprintf(stderr, "sim: trace %8u  %4u %7u %9u   0x%04X %7d %12d %6d %6d  %u/%u\n",
+			steps[i].ms,
+			steps[i].rssi,
+			s->changes,
+			(s->changes > 0) ? s->last_change_ms - steps[i].ms : 0,
+			s->reg13,
+			s->gain_dB,
+			seg_overshoot(s),
+			s->gain_diff[0],
+			s->gain_diff[1],
+			s->squelch_opens,
+			s->squelch_closes);
+	}
+
+	if (log_fp != NULL)
+	{
+		fclose(log_fp);
+		log_fp = NULL;
+	}
+}
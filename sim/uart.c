@@ -0,0 +1,55 @@
+// UART stand-in for the host simulator .. TX goes to stdout, nothing is received
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "driver/uart.h"
+#include "external/printf/printf.h"
+
+uint8_t UART_DMA_Buffer[256];
+
+void UART_Init(void)
+{
+}
+
+void UART_Send(const void *pBuffer, uint32_t Size)
+{
+	fwrite(pBuffer, 1, Size, stdout);
+	fflush(stdout);
+}
+
+void UART_SendText(const void *str)
+{
+	if (str)
+		UART_Send(str, strlen(str));
+}
+
+void UART_LogSend(const void *pBuffer, uint32_t Size)
+{
+	(void)pBuffer;
+	(void)Size;
+}
+
+void UART_LogSendText(const void *str)
+{
+	(void)str;
+}
+
+void UART_printf(const char *str, ...)
+{
+	char text[256];
+	int  len;
+
+	va_list va;
+	va_start(va, str);
+		len = vsnprintf(text, sizeof(text), str, va);
+	va_end(va);
+
+	UART_Send(text, len);
+}
+
+void _putchar(char character)
+{
+	UART_Send(&character, 1);
+}
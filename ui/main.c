@@ -432,7 +432,7 @@ void big_freq(const uint32_t frequency, const unsigned int x, const unsigned int
 	void UI_DisplayMain_pan(const bool now)
 	{
 		const unsigned int line      = (g_eeprom.config.setting.tx_vfo_num == 0) ? 4 : 0;
-		uint8_t           *base_line = g_frame_buffer[line + 2];
+		uint8_t           *top_line  = g_frame_buffer[line];
 		uint8_t            max_rssi;
 		uint8_t            min_rssi;
 		uint8_t            span_rssi;
@@ -483,14 +483,13 @@ void big_freq(const uint32_t frequency, const unsigned int x, const unsigned int
 		#endif
 
 		// draw top center vertical marker (the VFO frequency)
-		base_line[PANADAPTER_BINS - (LCD_WIDTH * 2)] = 0x0F;
+		top_line[PANADAPTER_BINS] = 0x0F;
 
 		// draw top horizontal dotted line
 		for (i = 0; i < PANADAPTER_BINS; i += 4)
 		{
-			const unsigned int k = PANADAPTER_BINS - (LCD_WIDTH * 2);
-			base_line[k - i] |= 1u;
-			base_line[k + i] |= 1u;
+			top_line[PANADAPTER_BINS - i] |= 1u;
+			top_line[PANADAPTER_BINS + i] |= 1u;
 		}
 
 		// draw the panadapter vertical bins
@@ -498,24 +497,31 @@ void big_freq(const uint32_t frequency, const unsigned int x, const unsigned int
 		{
 			uint32_t pixels;
 			uint8_t  rssi = g_panadapter_rssi[i];
+			uint8_t  peak = g_panadapter_peak[i];
 
 			#if 0
 				rssi = (rssi < ((-129 + 160) * 2)) ? 0 : rssi - ((-129 + 160) * 2);  // min of -129dBm (S3)
 				rssi = rssi >> 2;
 			#else
-				rssi = ((uint16_t)(rssi - min_rssi) * 21) / span_rssi;  // 0 ~ 21
+				// the noise floor isn't the lowest bin, anything under it sits on the bottom
+				rssi = (rssi > min_rssi) ? ((uint16_t)(rssi - min_rssi) * 21) / span_rssi : 0;  // 0 ~ 21
+				peak = (peak > min_rssi) ? ((uint16_t)(peak - min_rssi) * 21) / span_rssi : 0;
 			#endif
 
 			rssi += 2;                  // offset from the bottom
 			if (rssi > 22)
 				rssi = 22;              // limit peak value
+			peak += 2;
+			if (peak > 22)
+				peak = 22;
 
 			pixels = (1u << rssi) - 1;  // set the line pixels
+			pixels |= 1u << (peak - 1); // peak hold dot
 			pixels &= 0xfffffffe;       // clear the bottom line
 
-			base_line[i - (LCD_WIDTH * 2)] |= bit_reverse_8(pixels >> 16);
-			base_line[i - (LCD_WIDTH * 1)] |= bit_reverse_8(pixels >>  8);
-			base_line[i - (LCD_WIDTH * 0)] |= bit_reverse_8(pixels >>  0);
+			g_frame_buffer[line + 0][i] |= bit_reverse_8(pixels >> 16);
+			g_frame_buffer[line + 1][i] |= bit_reverse_8(pixels >>  8);
+			g_frame_buffer[line + 2][i] |= bit_reverse_8(pixels >>  0);
 		}
 
 		if (now)
@@ -31,6 +31,9 @@
 #include "helper/battery.h"
 #include "misc.h"
 #include "radio.h"
+#ifdef ENABLE_SCAN_LOG
+	#include "scan_log.h"
+#endif
 #include "settings.h"
 #include "ui/helper.h"
 #include "ui/inputbox.h"
@@ -38,144 +41,6 @@
 #include "ui/ui.h"
 #include "version.h"
 
-// ***************************************************************************************
-// NOTE. the oder of menu entries you on-screen is now solely determined by the enum list order in ui/menu.h
-//
-// the order of entries in this list below is no longer important, no longer has to match the enum list
-
-const t_menu_item g_menu_list[] =
-{
-//   text,     voice ID,                               menu ID
-
-	{"SQL",    VOICE_ID_SQUELCH,                       MENU_SQL                   },
-	{"CH SQL", VOICE_ID_SQUELCH,                       MENU_CHAN_SQL              },
-	{"STEP",   VOICE_ID_FREQUENCY_STEP,                MENU_STEP                  },
-	{"W/N",    VOICE_ID_CHANNEL_BANDWIDTH,             MENU_BANDWIDTH             },
-	{"Tx PWR", VOICE_ID_POWER,                         MENU_TX_POWER              }, // was "TXP"
-	{"Rx DCS", VOICE_ID_DCS,                           MENU_RX_CDCSS              }, // was "R_DCS"
-	{"Rx CTS", VOICE_ID_CTCSS,                         MENU_RX_CTCSS              }, // was "R_CTCS"
-	{"Tx DCS", VOICE_ID_DCS,                           MENU_TX_CDCSS              }, // was "T_DCS"
-	{"Tx CTS", VOICE_ID_CTCSS,                         MENU_TX_CTCSS              }, // was "T_CTCS"
-	{"Tx DIR", VOICE_ID_TX_OFFSET_FREQ_DIR,            MENU_SHIFT_DIR             }, // was "SFT_D"
-	{"Tx OFS", VOICE_ID_TX_OFFSET_FREQ,                MENU_OFFSET                }, // was "OFFSET"
-	{"Tx TO",  VOICE_ID_TRANSMIT_OVER_TIME,            MENU_TX_TO                 }, // was "TOT"
-	{"Tx VFO", VOICE_ID_INVALID,                       MENU_CROSS_VFO             }, // was "WX"
-	{"Dual W", VOICE_ID_DUAL_STANDBY,                  MENU_DUAL_WATCH            }, // was "TDR"
-	{"SC REV", VOICE_ID_INVALID,                       MENU_SCAN_CAR_RESUME       }, // was "SC_REV"
-	{"S HOLD", VOICE_ID_INVALID,                       MENU_SCAN_HOLD             },
-	{"SCRAM",  VOICE_ID_SCRAMBLER_ON,                  MENU_SCRAMBLER             }, // was "SCR"
-	{"BCL",    VOICE_ID_BUSY_LOCKOUT,                  MENU_BUSY_CHAN_LOCK        },
-	{"CH SAV", VOICE_ID_MEMORY_CHANNEL,                MENU_MEM_SAVE              }, // was "MEM-CH"
-	{"CH NAM", VOICE_ID_INVALID,                       MENU_MEM_NAME              },
-	{"CH DEL", VOICE_ID_DELETE_CHANNEL,                MENU_MEM_DEL               }, // was "DEL-CH"
-	{"CH DIS", VOICE_ID_INVALID,                       MENU_MEM_DISP              }, // was "MDF"
-	{"BatSAV", VOICE_ID_SAVE_MODE,                     MENU_BAT_SAVE              }, // was "SAVE"
-#ifdef ENABLE_VOX
-	{"VOX",    VOICE_ID_VOX,                           MENU_VOX                   },
-#endif
-	{"BL ",    VOICE_ID_INVALID,                       MENU_AUTO_BACKLITE         }, // was "ABR"
-	{"BL TRX", VOICE_ID_INVALID,                       MENU_AUTO_BACKLITE_ON_TX_RX},
-#ifdef ENABLE_CONTRAST
-	{"CTRAST", VOICE_ID_INVALID,                       MENU_CONTRAST              },
-#endif
-	{"BEEP",   VOICE_ID_BEEP_PROMPT,                   MENU_BEEP                  },
-#ifdef ENABLE_VOICE
-	{"VOICE",  VOICE_ID_VOICE_PROMPT,                  MENU_VOICE                 },
-#endif
-#ifdef ENABLE_KEYLOCK
-	{"KeyLOC", VOICE_ID_INVALID,                       MENU_AUTO_KEY_LOCK         }, // was "AUTOLk"
-#endif
-#ifdef ENABLE_SCAN_RANGES
-	{"SRANGE", VOICE_ID_INVALID,                       MENU_SCAN_RANGES           },
-#endif
-	{"S ADD1", VOICE_ID_INVALID,                       MENU_S_ADD1                },
-	{"S ADD2", VOICE_ID_INVALID,                       MENU_S_ADD2                },
-	{"STE",    VOICE_ID_INVALID,                       MENU_STE                   },
-	{"RP STE", VOICE_ID_INVALID,                       MENU_RP_STE                },
-	{"MIC GN", VOICE_ID_INVALID,                       MENU_MIC_GAIN              },
-	{"COMPND", VOICE_ID_INVALID,                       MENU_COMPAND               },
-#ifdef ENABLE_PANADAPTER
-	{"PANA",   VOICE_ID_INVALID,                       MENU_PANADAPTER            },
-#endif
-#ifdef ENABLE_TX_AUDIO_BAR
-	{"Tx BAR", VOICE_ID_INVALID,                       MENU_TX_BAR                },
-#endif
-#ifdef ENABLE_RX_SIGNAL_BAR
-	{"Rx BAR", VOICE_ID_INVALID,                       MENU_RX_BAR                },
-#endif
-	{"1 CALL", VOICE_ID_INVALID,                       MENU_1_CALL                },
-	{"SLIST",  VOICE_ID_INVALID,                       MENU_S_LIST                },
-	{"SLIST1", VOICE_ID_INVALID,                       MENU_SLIST1                },
-	{"SLIST2", VOICE_ID_INVALID,                       MENU_SLIST2                },
-#ifdef ENABLE_ALARM
-	{"SOS AL", VOICE_ID_INVALID,                       MENU_ALARM_MODE            }, // was "ALMODE"
-#endif
-	{"ANI ID", VOICE_ID_ANI_CODE,                      MENU_ANI_ID                },
-	{"UpCODE", VOICE_ID_INVALID,                       MENU_UP_CODE               },
-	{"DnCODE", VOICE_ID_INVALID,                       MENU_DN_CODE               }, // was "DWCODE"
-#ifdef ENABLE_MDC1200
-	{"MDCPTT", VOICE_ID_INVALID,                       MENU_MDC1200_MODE          },
-	{"MDC ID", VOICE_ID_INVALID,                       MENU_MDC1200_ID            },
-#endif
-	{"PTT ID", VOICE_ID_INVALID,                       MENU_PTT_ID                },
-	{"D ST",   VOICE_ID_INVALID,                       MENU_DTMF_ST               },
-    {"D RSP",  VOICE_ID_INVALID,                       MENU_DTMF_RSP              },
-	{"D HOLD", VOICE_ID_INVALID,                       MENU_DTMF_HOLD             },
-	{"D PRE",  VOICE_ID_INVALID,                       MENU_DTMF_PRE              },
-	{"D DCD",  VOICE_ID_INVALID,                       MENU_DTMF_DCD              },
-	{"D LIST", VOICE_ID_INVALID,                       MENU_DTMF_LIST             },
-	{"D LIVE", VOICE_ID_INVALID,                       MENU_DTMF_LIVE_DEC         }, // live DTMF decoder
-	{"PonMSG", VOICE_ID_INVALID,                       MENU_PON_MSG               },
-	{"ROGER",  VOICE_ID_INVALID,                       MENU_ROGER_MODE            },
-	{"BatVOL", VOICE_ID_INVALID,                       MENU_VOLTAGE               }, // was "VOL"
-	{"BatTXT", VOICE_ID_INVALID,                       MENU_BAT_TXT               },
-	{"MODE",   VOICE_ID_INVALID,                       MENU_MOD_MODE              }, // was "AM"
-#ifdef ENABLE_AM_FIX
-//	{"AM FIX", VOICE_ID_INVALID,                       MENU_AM_FIX                },
-#endif
-#ifdef ENABLE_AM_FIX_TEST1
-	{"AM FT1", VOICE_ID_INVALID,                       MENU_AM_FIX_TEST1          },
-#endif
-#ifdef ENABLE_NOAA
-	{"NOAA-S", VOICE_ID_INVALID,                       MENU_NOAA_SCAN             },
-#endif
-#ifdef ENABLE_SIDE_BUTT_MENU
-	{"Side1S", VOICE_ID_INVALID,                       MENU_SIDE1_SHORT           },
-	{"Side1L", VOICE_ID_INVALID,                       MENU_SIDE1_LONG            },
-	{"Side2S", VOICE_ID_INVALID,                       MENU_SIDE2_SHORT           },
-	{"Side2L", VOICE_ID_INVALID,                       MENU_SIDE2_LONG            },
-#endif
-	{"VER",    VOICE_ID_INVALID,                       MENU_VERSION               },
-	{"RESET",  VOICE_ID_INITIALISATION,                MENU_RESET                 }, // might be better to move this to the hidden menu items ?
-
-	// ************************************
-	// ************************************
-	// ************************************
-	// hidden menu items from here on
-	// enabled by pressing both the PTT and upper side button at power-on
-
-	{"BatCAL", VOICE_ID_INVALID,                       MENU_BAT_CAL               }, // battery voltage calibration
-
-#ifdef ENABLE_F_CAL_MENU
-	{"F CAL",  VOICE_ID_INVALID,                       MENU_F_CALI                }, // reference xtal calibration
-#endif
-
-	{"F LOCK", VOICE_ID_INVALID,                       MENU_FREQ_LOCK             }, // country/area specific
-	{"Tx 174", VOICE_ID_INVALID,                       MENU_174_TX                }, // was "200TX"
-	{"Tx 350", VOICE_ID_INVALID,                       MENU_350_TX                }, // was "350TX"
-	{"Tx 470", VOICE_ID_INVALID,                       MENU_470_TX                }, // was "500TX"
-	{"350 EN", VOICE_ID_INVALID,                       MENU_350_EN                }, // was "350EN"
-	{"SCR EN", VOICE_ID_INVALID,                       MENU_SCRAMBLER_EN          }, // was "SCREN"
-	{"Tx EN",  VOICE_ID_INVALID,                       MENU_TX_EN                 }, // enable TX
-
-	// ************************************
-	// ************************************
-	// ************************************
-};
-
-// number of hidden menu items at the end of the list - KEEP THIS CORRECT
-const unsigned int g_hidden_menu_count = 9;
-
 // ***************************************************************************************
 
 const char g_sub_menu_mod_mode[3][4] =
@@ -211,6 +76,15 @@ const char g_sub_menu_off_on[2][4] =
 	"ON"
 };
 
+#ifdef ENABLE_PANADAPTER
+	const char g_sub_menu_pan_revisit[3][16] =
+	{
+		"EVERY\nBURST",
+		"EVERY\n1/4 SWEEP",
+		"EVERY\nSWEEP"
+	};
+#endif
+
 const char g_sub_menu_bat_save[5][9] =
 {
 	"OFF",
@@ -392,8 +266,6 @@ const char g_sub_menu_side_butt[9][16] =
 
 // ***************************************************************************************
 
-uint8_t g_menu_list_sorted[ARRAY_SIZE(g_menu_list)];
-
 bool    g_in_sub_menu;
 uint8_t g_menu_cursor;
 int8_t  g_menu_scroll_direction;
@@ -406,57 +278,11 @@ int     g_edit_index;
 
 // ***************************************************************************************
 
-void sort_list(const unsigned int start, const unsigned int length)
-{
-	const unsigned int end = start + length;
-	unsigned int i;
-	for (i = start; i < end; i++)
-	{
-		unsigned int k;
-		for (k = 0; k < end; k++)
-		{
-			if (g_menu_list[k].menu_id == i)
-			{
-				g_menu_list_sorted[i] = k;
-				break;
-			}
-		}
-	}
-}
-
-void UI_SortMenu(const bool hide_hidden)
-{
-	// sort the menu order according to the MENU-ID value (enum list in id/menu.h)
-	//
-	// this means the menu order is entirely determined by the enum list (found in id/menu.h)
-	// it now no longer depends on the order of entries in the above const list (they can be any order)
-
-	unsigned int hidden_menu_count = g_hidden_menu_count;
-
-	#ifndef ENABLE_F_CAL_MENU
-		hidden_menu_count--;
-	#endif
-
-	g_menu_list_count = ARRAY_SIZE(g_menu_list);
-
-	// sort non-hidden entries at the beginning
-	sort_list(0, g_menu_list_count - hidden_menu_count);
-
-	// sort the hidden entries at the end
-	sort_list(g_menu_list_count - hidden_menu_count, hidden_menu_count);
-/*
-	#if defined(ENABLE_UART) && defined(ENABLE_UART_DEBUG)
-	{
-		unsigned int i;
-		UART_SendText("menu ..\r\n");
-		for (i = 0; i < ARRAY_SIZE(g_menu_list_sorted); i++)
-			UART_printf("%3u %3u %3u\r\n", i, g_menu_list_sorted[i], g_menu_list[g_menu_list_sorted[i]].menu_id);
-		UART_SendText("\r\n");
-	}
-	#endif
-*/
+void UI_init_menu(const bool hide_hidden)
+{	// the menu order (enum list in ui/menu.h) is worked out at build time, see utils/gen_tables.c
+	g_menu_list_count = g_menu_list_size;
 	if (hide_hidden)
-		g_menu_list_count -= hidden_menu_count;  // hide the hidden menu items
+		g_menu_list_count -= g_menu_list_hidden_count;  // hide the hidden menu items
 }
 
 void UI_DisplayMenu(void)
@@ -767,6 +593,11 @@ void UI_DisplayMenu(void)
 			case MENU_PANADAPTER:
 				strcpy(str, g_sub_menu_off_on[g_sub_menu_selection]);
 				break;
+
+			case MENU_PAN_REVISIT:
+				strcpy(str, "VFO CHECK\n");
+				strcat(str, g_sub_menu_pan_revisit[g_sub_menu_selection]);
+				break;
 		#endif
 
 		#ifdef ENABLE_TX_AUDIO_BAR
@@ -972,6 +803,46 @@ void UI_DisplayMenu(void)
 			sprintf(str + strlen(str), "%d.%d sec", g_sub_menu_selection / 2, 5 * (g_sub_menu_selection % 2));
 			break;
 
+		#ifdef ENABLE_SCAN_LOG
+			case MENU_SCAN_LOG:
+			{	// latest hit first
+				const unsigned int      count = SCAN_LOG_count();
+				const scan_log_entry_t *entry = (g_sub_menu_selection < (int32_t)count) ? SCAN_LOG_entry(count - 1 - g_sub_menu_selection) : NULL;
+				unsigned int            age;
+
+				if (entry == NULL)
+				{
+					strcpy(str, "SCAN LOG\nEMPTY");
+					break;
+				}
+
+				age = (g_global_sys_tick_counter - entry->tick_10ms) / 6000;   // minutes
+
+				sprintf(str, "%u/%u %um ago\n", 1 + g_sub_menu_selection, count, age);
+				if (IS_USER_CHANNEL(entry->channel))
+					sprintf(str + strlen(str), "CH-%03u\n", 1 + entry->channel);
+				else
+					sprintf(str + strlen(str), "%u.%05u\n", entry->frequency / 100000, entry->frequency % 100000);
+				sprintf(str + strlen(str), "%ddBm %u.%us\n", (entry->rssi_peak / 2) - 160, entry->duration_10ms / 100, (entry->duration_10ms / 10) % 10);
+				if (entry->code_type == CODE_TYPE_CONTINUOUS_TONE)
+					sprintf(str + strlen(str), "%u.%uHz", CTCSS_TONE_LIST[entry->code] / 10, CTCSS_TONE_LIST[entry->code] % 10);
+				else
+				if (entry->code_type == CODE_TYPE_DIGITAL || entry->code_type == CODE_TYPE_REVERSE_DIGITAL)
+					sprintf(str + strlen(str), "D%03o%c", DCS_CODE_LIST[entry->code], (entry->code_type == CODE_TYPE_DIGITAL) ? 'N' : 'I');
+				break;
+			}
+		#endif
+
+		#ifdef ENABLE_PRIORITY_LOOK_BACK
+			case MENU_PRI_LOOK_BACK:
+				strcpy(str, "PRIORITY\nLOOK BACK\n");
+				if (g_sub_menu_selection == 0)
+					strcat(str, "OFF");
+				else
+					sprintf(str + strlen(str), "%d.%d sec", g_sub_menu_selection / 10, g_sub_menu_selection % 10);
+				break;
+		#endif
+
 		case MENU_MEM_DISP:
 			strcpy(str, g_sub_menu_mem_disp[g_sub_menu_selection]);
 			break;
@@ -1214,6 +1085,17 @@ void UI_DisplayMenu(void)
 				break;
 		#endif
 
+		#ifdef ENABLE_AM_FIX
+			case MENU_AM_FIX_CAL:
+			{
+				const unsigned int cal = (g_sub_menu_selection < 0) ? -g_sub_menu_selection : g_sub_menu_selection;    // 0.5dB units
+				sprintf(str, "BAND %u\n%c%u.%udB",
+					1 + g_current_vfo->channel_attributes.band,
+					(g_sub_menu_selection < 0) ? '-' : '+', cal / 2, (cal & 1) * 5);
+				break;
+			}
+		#endif
+
 		case MENU_BAT_CAL:
 		{
 			const uint16_t vol = (uint32_t)g_battery_voltage_average * g_eeprom.calib.battery[3] / g_sub_menu_selection;
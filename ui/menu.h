@@ -29,7 +29,7 @@ typedef struct {
 } t_menu_item;
 
 // currently this list MUST be in exactly the same order
-// as the other menu list "g_menu_list[]" in "ui/menu.c", otherwise
+// as the other menu list "g_menu_list[]" in "ui/menu_list.c", otherwise
 // you'll have big problems
 //
 // I'm going to fix that so that you can reorder the menu items
@@ -76,6 +76,12 @@ enum
 #endif
 	MENU_S_ADD1,
 	MENU_S_ADD2,
+#ifdef ENABLE_PRIORITY_LOOK_BACK
+	MENU_PRI_LOOK_BACK,
+#endif
+#ifdef ENABLE_SCAN_LOG
+	MENU_SCAN_LOG,
+#endif
 #ifdef ENABLE_NOAA
 	MENU_NOAA_SCAN,
 #endif
@@ -86,6 +92,7 @@ enum
 	MENU_COMPAND,
 #ifdef ENABLE_PANADAPTER
 	MENU_PANADAPTER,
+	MENU_PAN_REVISIT,
 #endif
 #ifdef ENABLE_TX_AUDIO_BAR
 	MENU_TX_BAR,
@@ -152,6 +159,10 @@ enum
 	MENU_F_CALI,       // 26MHz reference xtal calibration
 #endif
 
+#ifdef ENABLE_AM_FIX
+	MENU_AM_FIX_CAL,   // per band AM RSSI calibration
+#endif
+
 	MENU_SCRAMBLER_EN, // scrambler enable/disable
 	MENU_FREQ_LOCK,    // lock to a selected region
 	MENU_350_EN,       // 350~400MHz enable/disable
@@ -166,13 +177,21 @@ enum
 };
 
 extern const t_menu_item  g_menu_list[];
-extern uint8_t            g_menu_list_sorted[];
+extern const uint8_t      g_menu_list_size;
+extern const unsigned int g_hidden_menu_count;
+
+// generated at build time by utils/gen_tables.c
+extern const uint8_t      g_menu_list_sorted[];
+extern const uint8_t      g_menu_list_hidden_count;
 
 extern const char         g_sub_menu_mod_mode[3][4];
 extern const char         g_sub_menu_tx_power[3][7];
 extern const char         g_sub_menu_shift_dir[3][4];
 extern const char         g_sub_menu_bandwidth[2][7];
 extern const char         g_sub_menu_off_on[2][4];
+#ifdef ENABLE_PANADAPTER
+	extern const char     g_sub_menu_pan_revisit[3][16];
+#endif
 extern const char         g_sub_menu_bat_save[5][9];
 extern const char         g_sub_menu_tx_timeout[11][7];
 extern const char         g_sub_menu_dual_watch[3][10];
@@ -214,7 +233,7 @@ extern char               g_edit_original[17];
 extern char               g_edit[17];
 extern int                g_edit_index;
 
-void UI_SortMenu(const bool hide_hidden);
+void UI_init_menu(const bool hide_hidden);
 void UI_DisplayMenu(void);
 
 #endif
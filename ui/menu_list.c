@@ -0,0 +1,170 @@
+/* Copyright 2023 Dual Tachyon
+ * https://github.com/DualTachyon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *     Unless required by applicable law or agreed to in writing, software
+ *     distributed under the License is distributed on an "AS IS" BASIS,
+ *     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *     See the License for the specific language governing permissions and
+ *     limitations under the License.
+ */
+
+#include "audio.h"
+#include "misc.h"
+#include "ui/menu.h"
+
+// ***************************************************************************************
+// NOTE. the oder of menu entries you on-screen is now solely determined by the enum list order in ui/menu.h
+//
+// the order of entries in this list below is no longer important, no longer has to match the enum list
+
+const t_menu_item g_menu_list[] =
+{
+//   text,     voice ID,                               menu ID
+
+	{"SQL",    VOICE_ID_SQUELCH,                       MENU_SQL                   },
+	{"CH SQL", VOICE_ID_SQUELCH,                       MENU_CHAN_SQL              },
+	{"STEP",   VOICE_ID_FREQUENCY_STEP,                MENU_STEP                  },
+	{"W/N",    VOICE_ID_CHANNEL_BANDWIDTH,             MENU_BANDWIDTH             },
+	{"Tx PWR", VOICE_ID_POWER,                         MENU_TX_POWER              }, // was "TXP"
+	{"Rx DCS", VOICE_ID_DCS,                           MENU_RX_CDCSS              }, // was "R_DCS"
+	{"Rx CTS", VOICE_ID_CTCSS,                         MENU_RX_CTCSS              }, // was "R_CTCS"
+	{"Tx DCS", VOICE_ID_DCS,                           MENU_TX_CDCSS              }, // was "T_DCS"
+	{"Tx CTS", VOICE_ID_CTCSS,                         MENU_TX_CTCSS              }, // was "T_CTCS"
+	{"Tx DIR", VOICE_ID_TX_OFFSET_FREQ_DIR,            MENU_SHIFT_DIR             }, // was "SFT_D"
+	{"Tx OFS", VOICE_ID_TX_OFFSET_FREQ,                MENU_OFFSET                }, // was "OFFSET"
+	{"Tx TO",  VOICE_ID_TRANSMIT_OVER_TIME,            MENU_TX_TO                 }, // was "TOT"
+	{"Tx VFO", VOICE_ID_INVALID,                       MENU_CROSS_VFO             }, // was "WX"
+	{"Dual W", VOICE_ID_DUAL_STANDBY,                  MENU_DUAL_WATCH            }, // was "TDR"
+	{"SC REV", VOICE_ID_INVALID,                       MENU_SCAN_CAR_RESUME       }, // was "SC_REV"
+	{"S HOLD", VOICE_ID_INVALID,                       MENU_SCAN_HOLD             },
+	{"SCRAM",  VOICE_ID_SCRAMBLER_ON,                  MENU_SCRAMBLER             }, // was "SCR"
+	{"BCL",    VOICE_ID_BUSY_LOCKOUT,                  MENU_BUSY_CHAN_LOCK        },
+	{"CH SAV", VOICE_ID_MEMORY_CHANNEL,                MENU_MEM_SAVE              }, // was "MEM-CH"
+	{"CH NAM", VOICE_ID_INVALID,                       MENU_MEM_NAME              },
+	{"CH DEL", VOICE_ID_DELETE_CHANNEL,                MENU_MEM_DEL               }, // was "DEL-CH"
+	{"CH DIS", VOICE_ID_INVALID,                       MENU_MEM_DISP              }, // was "MDF"
+	{"BatSAV", VOICE_ID_SAVE_MODE,                     MENU_BAT_SAVE              }, // was "SAVE"
+#ifdef ENABLE_VOX
+	{"VOX",    VOICE_ID_VOX,                           MENU_VOX                   },
+#endif
+	{"BL ",    VOICE_ID_INVALID,                       MENU_AUTO_BACKLITE         }, // was "ABR"
+	{"BL TRX", VOICE_ID_INVALID,                       MENU_AUTO_BACKLITE_ON_TX_RX},
+#ifdef ENABLE_CONTRAST
+	{"CTRAST", VOICE_ID_INVALID,                       MENU_CONTRAST              },
+#endif
+	{"BEEP",   VOICE_ID_BEEP_PROMPT,                   MENU_BEEP                  },
+#ifdef ENABLE_VOICE
+	{"VOICE",  VOICE_ID_VOICE_PROMPT,                  MENU_VOICE                 },
+#endif
+#ifdef ENABLE_KEYLOCK
+	{"KeyLOC", VOICE_ID_INVALID,                       MENU_AUTO_KEY_LOCK         }, // was "AUTOLk"
+#endif
+#ifdef ENABLE_SCAN_RANGES
+	{"SRANGE", VOICE_ID_INVALID,                       MENU_SCAN_RANGES           },
+#endif
+	{"S ADD1", VOICE_ID_INVALID,                       MENU_S_ADD1                },
+	{"S ADD2", VOICE_ID_INVALID,                       MENU_S_ADD2                },
+#ifdef ENABLE_PRIORITY_LOOK_BACK
+	{"PRI LK", VOICE_ID_INVALID,                       MENU_PRI_LOOK_BACK         },
+#endif
+#ifdef ENABLE_SCAN_LOG
+	{"S LOG",  VOICE_ID_INVALID,                       MENU_SCAN_LOG              },
+#endif
+	{"STE",    VOICE_ID_INVALID,                       MENU_STE                   },
+	{"RP STE", VOICE_ID_INVALID,                       MENU_RP_STE                },
+	{"MIC GN", VOICE_ID_INVALID,                       MENU_MIC_GAIN              },
+	{"COMPND", VOICE_ID_INVALID,                       MENU_COMPAND               },
+#ifdef ENABLE_PANADAPTER
+	{"PANA",   VOICE_ID_INVALID,                       MENU_PANADAPTER            },
+	{"PAN RV", VOICE_ID_INVALID,                       MENU_PAN_REVISIT           },
+#endif
+#ifdef ENABLE_TX_AUDIO_BAR
+	{"Tx BAR", VOICE_ID_INVALID,                       MENU_TX_BAR                },
+#endif
+#ifdef ENABLE_RX_SIGNAL_BAR
+	{"Rx BAR", VOICE_ID_INVALID,                       MENU_RX_BAR                },
+#endif
+	{"1 CALL", VOICE_ID_INVALID,                       MENU_1_CALL                },
+	{"SLIST",  VOICE_ID_INVALID,                       MENU_S_LIST                },
+	{"SLIST1", VOICE_ID_INVALID,                       MENU_SLIST1                },
+	{"SLIST2", VOICE_ID_INVALID,                       MENU_SLIST2                },
+#ifdef ENABLE_ALARM
+	{"SOS AL", VOICE_ID_INVALID,                       MENU_ALARM_MODE            }, // was "ALMODE"
+#endif
+	{"ANI ID", VOICE_ID_ANI_CODE,                      MENU_ANI_ID                },
+	{"UpCODE", VOICE_ID_INVALID,                       MENU_UP_CODE               },
+	{"DnCODE", VOICE_ID_INVALID,                       MENU_DN_CODE               }, // was "DWCODE"
+#ifdef ENABLE_MDC1200
+	{"MDCPTT", VOICE_ID_INVALID,                       MENU_MDC1200_MODE          },
+	{"MDC ID", VOICE_ID_INVALID,                       MENU_MDC1200_ID            },
+#endif
+	{"PTT ID", VOICE_ID_INVALID,                       MENU_PTT_ID                },
+	{"D ST",   VOICE_ID_INVALID,                       MENU_DTMF_ST               },
+    {"D RSP",  VOICE_ID_INVALID,                       MENU_DTMF_RSP              },
+	{"D HOLD", VOICE_ID_INVALID,                       MENU_DTMF_HOLD             },
+	{"D PRE",  VOICE_ID_INVALID,                       MENU_DTMF_PRE              },
+	{"D DCD",  VOICE_ID_INVALID,                       MENU_DTMF_DCD              },
+	{"D LIST", VOICE_ID_INVALID,                       MENU_DTMF_LIST             },
+	{"D LIVE", VOICE_ID_INVALID,                       MENU_DTMF_LIVE_DEC         }, // live DTMF decoder
+	{"PonMSG", VOICE_ID_INVALID,                       MENU_PON_MSG               },
+	{"ROGER",  VOICE_ID_INVALID,                       MENU_ROGER_MODE            },
+	{"BatVOL", VOICE_ID_INVALID,                       MENU_VOLTAGE               }, // was "VOL"
+	{"BatTXT", VOICE_ID_INVALID,                       MENU_BAT_TXT               },
+	{"MODE",   VOICE_ID_INVALID,                       MENU_MOD_MODE              }, // was "AM"
+#ifdef ENABLE_AM_FIX
+//	{"AM FIX", VOICE_ID_INVALID,                       MENU_AM_FIX                },
+#endif
+#ifdef ENABLE_AM_FIX_TEST1
+	{"AM FT1", VOICE_ID_INVALID,                       MENU_AM_FIX_TEST1          },
+#endif
+#ifdef ENABLE_NOAA
+	{"NOAA-S", VOICE_ID_INVALID,                       MENU_NOAA_SCAN             },
+#endif
+#ifdef ENABLE_SIDE_BUTT_MENU
+	{"Side1S", VOICE_ID_INVALID,                       MENU_SIDE1_SHORT           },
+	{"Side1L", VOICE_ID_INVALID,                       MENU_SIDE1_LONG            },
+	{"Side2S", VOICE_ID_INVALID,                       MENU_SIDE2_SHORT           },
+	{"Side2L", VOICE_ID_INVALID,                       MENU_SIDE2_LONG            },
+#endif
+	{"VER",    VOICE_ID_INVALID,                       MENU_VERSION               },
+	{"RESET",  VOICE_ID_INITIALISATION,                MENU_RESET                 }, // might be better to move this to the hidden menu items ?
+
+	// ************************************
+	// ************************************
+	// ************************************
+	// hidden menu items from here on
+	// enabled by pressing both the PTT and upper side button at power-on
+
+	{"BatCAL", VOICE_ID_INVALID,                       MENU_BAT_CAL               }, // battery voltage calibration
+
+#ifdef ENABLE_F_CAL_MENU
+	{"F CAL",  VOICE_ID_INVALID,                       MENU_F_CALI                }, // reference xtal calibration
+#endif
+
+#ifdef ENABLE_AM_FIX
+	{"AM CAL", VOICE_ID_INVALID,                       MENU_AM_FIX_CAL            }, // per band AM RSSI calibration
+#endif
+
+	{"F LOCK", VOICE_ID_INVALID,                       MENU_FREQ_LOCK             }, // country/area specific
+	{"Tx 174", VOICE_ID_INVALID,                       MENU_174_TX                }, // was "200TX"
+	{"Tx 350", VOICE_ID_INVALID,                       MENU_350_TX                }, // was "350TX"
+	{"Tx 470", VOICE_ID_INVALID,                       MENU_470_TX                }, // was "500TX"
+	{"350 EN", VOICE_ID_INVALID,                       MENU_350_EN                }, // was "350EN"
+	{"SCR EN", VOICE_ID_INVALID,                       MENU_SCRAMBLER_EN          }, // was "SCREN"
+	{"Tx EN",  VOICE_ID_INVALID,                       MENU_TX_EN                 }, // enable TX
+
+	// ************************************
+	// ************************************
+	// ************************************
+};
+
+const uint8_t g_menu_list_size = ARRAY_SIZE(g_menu_list);
+
+// number of hidden menu items at the end of the list - KEEP THIS CORRECT
+const unsigned int g_hidden_menu_count = 10;
@@ -47,7 +47,10 @@ void UI_DisplaySearch(void)
 		case SEARCH_CSS_STATE_OFF:
 			if (!g_search_single_frequency)
 			{
-				strcpy(String, "FREQ scanning");
+				if (g_search_vote[0].score == 0)
+					strcpy(String, "FREQ scanning");
+				else
+					sprintf(String, "FREQ %u.%05u", g_search_vote[0].value / 100000, g_search_vote[0].value % 100000);
 				break;
 			}
 			
@@ -70,6 +73,25 @@ void UI_DisplaySearch(void)
 
 	UI_PrintString(String, 2, 0, 1, 8);
 
+	// ***********************************
+	// live search votes .. how close the leader is to winning, and how many others there are
+
+	if ((g_search_css_state == SEARCH_CSS_STATE_OFF && !g_search_single_frequency) || g_search_css_state == SEARCH_CSS_STATE_SCANNING)
+	{
+		if (g_search_vote[0].score > 0)
+		{
+			const unsigned int percent = (g_search_vote[0].score >= SEARCH_VOTE_WIN) ? 99 : (g_search_vote[0].score * 100u) / SEARCH_VOTE_WIN;
+			unsigned int       others  = 0;
+
+			for (unsigned int i = 1; i < ARRAY_SIZE(g_search_vote); i++)
+				if (g_search_vote[i].score > 0)
+					others++;
+
+			sprintf(String, "LEAD %2u%% +%u MORE", percent, others);
+			UI_PrintStringSmall(String, 0, 127, 0);
+		}
+	}
+
 	// ***********************************
 	// CODE text line
 	
@@ -83,7 +105,10 @@ void UI_DisplaySearch(void)
 			break;
 
 		case SEARCH_CSS_STATE_SCANNING:
-			strcpy(String, "CODE scanning");
+			if (g_search_vote[0].score == 0)
+				strcpy(String, "CODE scanning");
+			else
+				sprintf(String, "CTCSS %u.%uHz", CTCSS_TONE_LIST[g_search_vote[0].value] / 10, CTCSS_TONE_LIST[g_search_vote[0].value] % 10);
 			break;
 
 		case SEARCH_CSS_STATE_FOUND:
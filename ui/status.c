@@ -14,6 +14,8 @@
  *     limitations under the License.
  */
 
+#include <string.h>
+
 #include "app/search.h"
 #ifdef ENABLE_FMRADIO
 	#include "app/fm.h"
@@ -120,6 +122,17 @@ void UI_DisplayStatus(const bool test_display)
 			}
 		}
 		x += 7 + 1;  // font character width + 1
+
+		#ifdef ENABLE_FASTER_CHANNEL_SCAN
+			// measured scan rate, hops per second
+			if (g_current_display_screen != DISPLAY_SEARCH && g_scan_hops_per_sec > 0)
+			{
+				char s[6];
+				sprintf(s, "%u", g_scan_hops_per_sec);
+				UI_PrintStringSmallBuffer(s, line + x);
+				x += (7 * strlen(s)) + 1;
+			}
+		#endif
 	}
 
 	#ifdef ENABLE_VOICE
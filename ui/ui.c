@@ -21,6 +21,7 @@
 #include "app/search.h"
 #include "driver/keyboard.h"
 #include "misc.h"
+#include "profile.h"
 #ifdef ENABLE_AIRCOPY
 	#include "ui/aircopy.h"
 #endif
@@ -41,6 +42,8 @@ bool               g_ask_to_delete;
 
 void GUI_DisplayScreen(void)
 {
+	PROFILE_start(PROFILE_DISPLAY);
+
 	g_update_display = false;
 
 	switch (g_current_display_screen)
@@ -72,6 +75,8 @@ void GUI_DisplayScreen(void)
 		default:
 			break;
 	}
+
+	PROFILE_stop(PROFILE_DISPLAY);
 }
 
 void GUI_SelectNextDisplay(gui_display_type_t Display)
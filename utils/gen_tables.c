@@ -0,0 +1,177 @@
+// build-time table generator
+//
+// built and run on the host by the Makefile with the same ENABLE_* defines as
+// the firmware, it writes the look-up tables the firmware used to work out at
+// every power-on out as a C source file of const tables
+//
+//   step_freq_table_sorted[]  .. STEP_FREQ_TABLE indices, smallest step first
+//   g_menu_list_sorted[]      .. g_menu_list indices in menu ID order
+//   g_menu_list_hidden_count  .. number of hidden menu items at the end
+//   dcs_code_index[]          .. DCS_CODE_LIST index of each 9-bit DCS code
+//   dcs_golay_parity[]        .. Golay parity bits of each DCS code
+//
+// the lists are sanity checked on the way, anything wrong with them fails the build
+//
+//   ./gen_tables <output file>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dcs.h"
+#include "frequencies.h"
+#include "misc.h"
+#include "settings.h"
+#include "ui/menu.h"
+
+// the rest of what frequencies.c and dcs.c refer to, never used in here
+t_eeprom       g_eeprom;
+const uint8_t  step_freq_table_sorted[ARRAY_SIZE(STEP_FREQ_TABLE)];
+const uint8_t  dcs_code_index[512];
+const uint16_t dcs_golay_parity[ARRAY_SIZE(DCS_CODE_LIST)];
+
+static const char *gen_name;
+
+static void fail(const char *msg, const unsigned int value)
+{
+	fprintf(stderr, "%s: %s (%u)\n", gen_name, msg, value);
+	exit(1);
+}
+
+static void write_table(FILE *fp, const char *comment, const char *name, const uint8_t *table, const unsigned int size)
+{
+	fprintf(fp, "// %s\nconst uint8_t %s[%u] =\n{", comment, name, size);
+	for (unsigned int i = 0; i < size; i++)
+		fprintf(fp, "%s%3u,", ((i % 16) == 0) ? "\n\t" : " ", table[i]);
+	fprintf(fp, "\n};\n\n");
+}
+
+static void write_table16(FILE *fp, const char *comment, const char *name, const uint16_t *table, const unsigned int size)
+{
+	fprintf(fp, "// %s\nconst uint16_t %s[%u] =\n{", comment, name, size);
+	for (unsigned int i = 0; i < size; i++)
+		fprintf(fp, "%s0x%03X,", ((i % 8) == 0) ? "\n\t" : " ", table[i]);
+	fprintf(fp, "\n};\n\n");
+}
+
+static void gen_step_table(uint8_t *sorted)
+{	// same order the old boot-time sort gave, the step sizes have to be unique for it to mean anything
+	const unsigned int count = ARRAY_SIZE(STEP_FREQ_TABLE);
+
+	for (unsigned int i = 0; i < count; i++)
+		sorted[i] = i;
+
+	for (unsigned int i = 0; i < count - 1; i++)
+	{
+		for (unsigned int k = i + 1; k < count; k++)
+		{
+			if (STEP_FREQ_TABLE[sorted[k]] == STEP_FREQ_TABLE[sorted[i]])
+				fail("duplicate step size", STEP_FREQ_TABLE[sorted[k]]);
+
+			if (STEP_FREQ_TABLE[sorted[k]] < STEP_FREQ_TABLE[sorted[i]])
+			{
+				const uint8_t temp = sorted[i];
+				sorted[i] = sorted[k];
+				sorted[k] = temp;
+			}
+		}
+	}
+}
+
+static unsigned int gen_menu_table(uint8_t *sorted)
+{	// every menu ID must turn up exactly once, the hidden ones within the hidden block at the end of the list
+	const unsigned int count        = g_menu_list_size;
+	unsigned int       hidden_count = g_hidden_menu_count;
+
+	#ifndef ENABLE_F_CAL_MENU
+		hidden_count--;
+	#endif
+	#ifndef ENABLE_AM_FIX
+		hidden_count--;
+	#endif
+
+	if (hidden_count > count)
+		fail("more hidden menu items than menu items", hidden_count);
+
+	for (unsigned int i = 0; i < count; i++)
+		sorted[i] = 0xff;
+
+	for (unsigned int k = 0; k < count; k++)
+	{
+		const unsigned int id = g_menu_list[k].menu_id;
+
+		if (id >= count)
+			fail("menu ID out of range, check the #ifdef's in ui/menu.h against ui/menu_list.c", id);
+		if (sorted[id] != 0xff)
+			fail("menu ID used twice", id);
+		if ((id >= count - hidden_count) != (k >= count - hidden_count))
+			fail("hidden menu item outside the hidden block, check g_hidden_menu_count", id);
+
+		sorted[id] = k;
+	}
+
+	return hidden_count;
+}
+
+static void gen_dcs_tables(uint8_t *index, uint16_t *parity)
+{	// the codes must fit in 9 bits and be unique for the look-up to work
+	for (unsigned int i = 0; i < 512; i++)
+		index[i] = 0xff;
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(DCS_CODE_LIST); i++)
+	{
+		const unsigned int code = DCS_CODE_LIST[i];
+
+		if (code >= 512)
+			fail("DCS code wider than 9 bits", code);
+		if (index[code] != 0xff)
+			fail("duplicate DCS code", code);
+
+		index[code] = i;
+		parity[i]   = DCS_GetGolayCodeWord(CODE_TYPE_DIGITAL, i) >> 12;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	static uint8_t  step_sorted[ARRAY_SIZE(STEP_FREQ_TABLE)];
+	static uint8_t  menu_sorted[256];
+	static uint8_t  dcs_index[512];
+	static uint16_t dcs_parity[ARRAY_SIZE(DCS_CODE_LIST)];
+	unsigned int    hidden_count;
+	FILE           *fp;
+
+	gen_name = argv[0];
+
+	if (argc != 2)
+	{
+		fprintf(stderr, "usage: %s <output file>\n", argv[0]);
+		return 1;
+	}
+
+	gen_step_table(step_sorted);
+	hidden_count = gen_menu_table(menu_sorted);
+	gen_dcs_tables(dcs_index, dcs_parity);
+
+	fp = fopen(argv[1], "w");
+	if (fp == NULL)
+	{
+		perror(argv[1]);
+		return 1;
+	}
+
+	fprintf(fp, "// generated by utils/gen_tables.c, DO NOT EDIT\n\n");
+	fprintf(fp, "#include \"dcs.h\"\n#include \"frequencies.h\"\n#include \"ui/menu.h\"\n\n");
+	write_table(fp, "STEP_FREQ_TABLE indices in ascending step size order", "step_freq_table_sorted", step_sorted, ARRAY_SIZE(step_sorted));
+	write_table(fp, "g_menu_list indices in menu ID order (ui/menu.h), hidden items last", "g_menu_list_sorted", menu_sorted, g_menu_list_size);
+	fprintf(fp, "const uint8_t g_menu_list_hidden_count = %u;\n\n", hidden_count);
+	write_table(fp, "DCS_CODE_LIST index of each 9-bit DCS code, 0xff = not a code", "dcs_code_index", dcs_index, ARRAY_SIZE(dcs_index));
+	write_table16(fp, "Golay parity bits <22:12> of each DCS_CODE_LIST codeword", "dcs_golay_parity", dcs_parity, ARRAY_SIZE(dcs_parity));
+
+	if (fclose(fp) != 0)
+	{
+		perror(argv[1]);
+		return 1;
+	}
+
+	return 0;
+}